@@ -1,19 +1,26 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GeoTechMinesweeper.h"
+#include "MinesweeperFixedBoard.h"
+#include "MinesweeperHeatmap.h"
+#include "MinesweeperSimulation.h"
+#include "SMinesweeperBoardView.h"
+#include "SMinesweeperPerfHud.h"
 
 #if WITH_EDITOR
 #include "SListViewSelectorDropdownMenu.h"
 #endif
-#include "Dialog/SMessageDialog.h"
 #include "Modules/ModuleManager.h"
 #include "Styling/SlateStyleRegistry.h"
 #include "Styling/UMGCoreStyle.h"
 #include "Widgets/SCanvas.h"
+#include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SNumericEntryBox.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE(FGeoTechMinesweeperModule, GeoTechMinesweeper, "GeoTechMinesweeper");
 
+DEFINE_LOG_CATEGORY(LogMinesweeper);
+
 void FGeoTechMinesweeperModule::StartupModule()
 {
 	IModuleInterface::StartupModule();
@@ -141,7 +148,7 @@ int FGeoTechMinesweeperModule::StartMinesweeper()
 							return GameWidth;
 						})
 						.OnValueChanged_Lambda([this](int NewValue) {
-							GameWidth = FMath::Clamp(NewValue, 1, 256);
+							GameWidth = FMath::Clamp(NewValue, 1, 4096);
 						})
 						.IsEnabled_Lambda([this] {
 							return !Minesweeper.IsValid() && CurrentDifficulty == NAME_Custom;
@@ -165,7 +172,7 @@ int FGeoTechMinesweeperModule::StartMinesweeper()
 							return GameHeight;
 						})
 						.OnValueChanged_Lambda([this](int NewValue) {
-							GameHeight = FMath::Clamp(NewValue, 1, 256);
+							GameHeight = FMath::Clamp(NewValue, 1, 4096);
 						})
 						.IsEnabled_Lambda([this] {
 							return !Minesweeper.IsValid() && CurrentDifficulty == NAME_Custom;
@@ -207,6 +214,10 @@ int FGeoTechMinesweeperModule::StartMinesweeper()
 							if (Minesweeper.IsValid()) {
 								return INVTEXT("End");
 							}
+
+							if (PendingGame.IsValid()) {
+								return INVTEXT("Generating...");
+							}
 							
 							return INVTEXT("Begin");
 						})
@@ -215,9 +226,28 @@ int FGeoTechMinesweeperModule::StartMinesweeper()
 								Minesweeper.Reset();
 								return FReply::Handled();
 							}
+
+							if (PendingGame.IsValid()) {
+								return FReply::Handled();
+							}
+
+							const int Width = GameWidth, Height = GameHeight, MineCount = GameMineCount;
+							const int Seed = FMinesweeperGame::MakeSeed();
+							PendingGame = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Width, Height, MineCount, Seed] {
+								return FMinesweeperGame::Create(Width, Height, MineCount, Seed);
+							});
+
+							GameArea->RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateLambda([this](double InCurrentTime, float InDeltaTime) {
+								if (!PendingGame.IsCompleted()) {
+									return EActiveTimerReturnType::Continue;
+								}
+
+								Minesweeper = PendingGame.GetResult();
+								PendingGame = {};
+								Minesweeper->SetPlayArea(GameArea);
+								return EActiveTimerReturnType::Stop;
+							}));
 							
-							Minesweeper = MakeShareable<FMinesweeperGame>(new FMinesweeperGame(GameWidth, GameHeight, GameMineCount));
-							Minesweeper->SetPlayArea(GameArea);
 							return FReply::Handled();
 						})
 					]
@@ -238,6 +268,11 @@ int FGeoTechMinesweeperModule::StartMinesweeper()
 	App.AddModalWindow(Window, Parent, false);
 	
 	// After modal closed, cleanup
+	if (PendingGame.IsValid()) {
+		PendingGame.Wait();
+		PendingGame = {};
+	}
+	
 	Minesweeper.Reset();
 	
 	return 0;
@@ -296,16 +331,59 @@ FReply SMineButton::ExecuteOnRightClick()
 }
 
 FMinesweeperGame::FMinesweeperGame(const int InWidth, const int InHeight, const int InMineCount)
+	: FMinesweeperGame(InWidth, InHeight, InMineCount, MakeSeed())
+{
+}
+
+FMinesweeperGame::FMinesweeperGame(const int InWidth, const int InHeight, const int InMineCount, const int Seed)
+	: FMinesweeperGame(InWidth, InHeight, InMineCount, nullptr)
+{
+	Board = new FMinesweeperTile[Width * Height];
+	bOwnsBoard = true;
+
+	Initialize(Seed);
+}
+
+FMinesweeperGame::FMinesweeperGame(const int InWidth, const int InHeight, const int InMineCount, FMinesweeperTile* InBoard)
 {
 	Width = InWidth;
 	Height = InHeight;
 
 	// I suppose you could play on hard mode and make it the total area but thats just kinda weird 
 	MineCount = FMath::Clamp(InMineCount, 1, Width * Height);
-	
-	Board = new FMinesweeperTile[Width * Height];
-	PlayAreaGridWidgets = new SGridPanel::FSlot*[Width * Height];
 
+	Board = InBoard;
+}
+
+TSharedPtr<FMinesweeperGame> FMinesweeperGame::Create(const int InWidth, const int InHeight, const int InMineCount, const int Seed)
+{
+	// The presets get their board inline with the neighbor math done at compile time
+	if (FEasyMinesweeperBoard::Matches(InWidth, InHeight, InMineCount)) {
+		return MakeShared<FEasyMinesweeperBoard>(Seed);
+	}
+
+	if (FMediumMinesweeperBoard::Matches(InWidth, InHeight, InMineCount)) {
+		return MakeShared<FMediumMinesweeperBoard>(Seed);
+	}
+
+	if (FHardMinesweeperBoard::Matches(InWidth, InHeight, InMineCount)) {
+		return MakeShared<FHardMinesweeperBoard>(Seed);
+	}
+
+	if (FImpossibleMinesweeperBoard::Matches(InWidth, InHeight, InMineCount)) {
+		return MakeShared<FImpossibleMinesweeperBoard>(Seed);
+	}
+
+	return MakeShared<FMinesweeperGame>(InWidth, InHeight, InMineCount, Seed);
+}
+
+TSharedPtr<FMinesweeperGame> FMinesweeperGame::Create(const int InWidth, const int InHeight, const int InMineCount)
+{
+	return Create(InWidth, InHeight, InMineCount, MakeSeed());
+}
+
+void FMinesweeperGame::Initialize(const int Seed)
+{
 	// Generate play area
 	for (int i = 0; i < Width; i++) {
 		for (int j = 0; j < Height; j++) {
@@ -315,33 +393,75 @@ FMinesweeperGame::FMinesweeperGame(const int InWidth, const int InHeight, const
 			Tile.Position = { i, j };
 		}
 	}
+
+	// Set minefield randomly
+	GenerateMines(Width, Height, MineCount, Seed, MineIndices);
+	PlaceMines();
+
+	AnalyzeBoard();
+	
+	GameState = Playing;
+}
+
+void FMinesweeperGame::PlaceMines()
+{
+	for (const int Index : MineIndices) {
+		Board[Index].IsMine = true;
+	}
+}
+
+int FMinesweeperGame::MakeSeed()
+{
+	// Mixed with the clock so two games started from the same CRT state still differ
+	return static_cast<int>(FMath::Rand32() ^ static_cast<uint32>(FPlatformTime::Cycles64()));
+}
+
+void FMinesweeperGame::GenerateMines(const int InWidth, const int InHeight, const int InMineCount, const int Seed, TArray<int>& OutMineIndices)
+{
+	const int CellCount = InWidth * InHeight;
+	const int Count = FMath::Clamp(InMineCount, 1, CellCount);
+
+	FRandomStream Stream(Seed);
+	TBitArray<> Placed(false, CellCount);
+
+	OutMineIndices.Reset(Count);
 	
-	int MineCountCopy = MineCount;
+	int MineCountCopy = Count;
 	while (MineCountCopy-- > 0) {
-		const int X = FMath::RandRange(0, Width - 1);
-		const int Y = FMath::RandRange(0, Height - 1);
+		const int X = Stream.RandRange(0, InWidth - 1);
+		const int Y = Stream.RandRange(0, InHeight - 1);
 
-		auto& Tile = GetTile(X, Y);
-		if (Tile.IsMine) {
+		const int Index = X + Y * InWidth;
+		if (Placed[Index]) {
 			MineCountCopy++;
 			continue;
 		}
 
-		// Set minefield randomly
-		Tile.IsMine = true;
+		Placed[Index] = true;
+		OutMineIndices.Add(Index);
 	}
-	
-	GameState = Playing;
 }
 
 FMinesweeperGame::~FMinesweeperGame()
 {
+	StopSimulation();
+	
+	// Whatever is still in flight finishes against its own snapshot and gets thrown away
+	if (HeatmapSolver) {
+		HeatmapSolver->Cancel();
+	}
+	
 	if (PlayBorder) {
+		if (SimulationTimerHandle) {
+			PlayBorder->UnRegisterActiveTimer(SimulationTimerHandle.ToSharedRef());
+		}
+		
 		PlayBorder->ClearContent();
 	}
 		
-	delete Board;
-	delete PlayAreaGridWidgets;
+	if (bOwnsBoard) {
+		delete[] Board;
+	}
 }
 
 bool FMinesweeperGame::SetPlayArea(TSharedPtr<SBorder> Panel)
@@ -349,33 +469,126 @@ bool FMinesweeperGame::SetPlayArea(TSharedPtr<SBorder> Panel)
 	if (!Panel) {
 		return false;
 	}
-	
-	constexpr double ButtonSizePx = 32.0;
-	constexpr double ButtonImageRelativeSize = 0.78;
-	const FVector2d ButtonSize(ButtonSizePx, ButtonSizePx);
+
+	// Rules move to their own thread from here on, everything built below draws from its snapshots
+	Simulation = MakeUnique<FMinesweeperSimulation>(*this);
+
+	const bool bUseBoardView = Width > MaxWidgetGridSize || Height > MaxWidgetGridSize;
+	TSharedRef<SWidget> BoardWidget = bUseBoardView ? CreateBoardView() : CreateTileGrid();
+
+#if WITH_MINESWEEPER_PERF_HUD
+	// Only ticks while shown, the board paint is timed either way so the first sample after toggling it on is already there
+	SAssignNew(PerfHud, SMinesweeperPerfHud)
+		.Game(this)
+		.Visibility_Lambda([this] {
+			return bShowPerfHud ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+		});
+
+	BoardWidget = SNew(SMinesweeperPaintTimer)
+		.PerfHud(PerfHud)
+		[
+			BoardWidget
+		];
+#endif
+
+	TSharedPtr<SOverlay> Overlay;
+	TSharedPtr<SHorizontalBox> Footer;
 	
 	const TSharedPtr<SVerticalBox> VerticalBox = SNew(SVerticalBox)
 		+ SVerticalBox::Slot()
 		[
-			SAssignNew(PlayAreaWidget, SGridPanel)
+			// Result sits over the board rather than in a modal, so nothing has to pump the application for it
+			SAssignNew(Overlay, SOverlay)
+			+ SOverlay::Slot()
+			[
+				BoardWidget
+			]
+			+ SOverlay::Slot()
+			[
+				CreateResultOverlay()
+			]
 		]
 		+ SVerticalBox::Slot()
 	    .AutoHeight()
 	    [
-	        SNew(SHorizontalBox)
+	        SAssignNew(Footer, SHorizontalBox)
 	        + SHorizontalBox::Slot()
 	        [
         		SNew(STextBlock)
         		.Text_Lambda([this] {
-        			const FString MinesRemainingText = FString::Printf(L"Mines Remaining: %d", FMath::Max<int>(0, MineCount - FlagsPlaced));
+        			const FString MinesRemainingText = FString::Printf(L"Mines Remaining: %d", FMath::Max<int>(0, MineCount - GetDisplay().View.FlagsPlaced));
 					return FText::FromString(MinesRemainingText);
         		})
 	        ]
+	        + SHorizontalBox::Slot()
+	        .AutoWidth()
+	        .Padding(FMargin(0.0f, 0.0f, 7.0f, 0.0f))
+	        [
+	        	SNew(SCheckBox)
+	        	.IsChecked_Lambda([this] {
+	        		return IsHeatmapEnabled() ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+	        	})
+	        	.OnCheckStateChanged_Lambda([this](ECheckBoxState State) {
+	        		SetHeatmapEnabled(State == ECheckBoxState::Checked);
+	        	})
+	        	[
+	        		SNew(STextBlock)
+	        		.Text(INVTEXT("Heatmap"))
+	        	]
+	        ]
+	        + SHorizontalBox::Slot()
+	        .AutoWidth()
+	        [
+	        	SNew(STextBlock)
+	        	.Text_Lambda([this] {
+	        		return FText::FromString(FString::Printf(L"3BV: %d/%d", GetDisplay().SolvedThreeBV, ThreeBV));
+	        	})
+	        ]
 	    ];
+
+#if WITH_MINESWEEPER_PERF_HUD
+	Overlay->AddSlot()
+		.HAlign(HAlign_Left)
+		.VAlign(VAlign_Top)
+		[
+			PerfHud.ToSharedRef()
+		];
+
+	Footer->AddSlot()
+		.AutoWidth()
+		.Padding(FMargin(7.0f, 0.0f, 0.0f, 0.0f))
+		[
+			SNew(SCheckBox)
+			.IsChecked_Lambda([this] {
+				return bShowPerfHud ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			})
+			.OnCheckStateChanged_Lambda([this](ECheckBoxState State) {
+				bShowPerfHud = State == ECheckBoxState::Checked;
+			})
+			[
+				SNew(STextBlock)
+				.Text(INVTEXT("Perf"))
+			]
+		];
+#endif
+
+	Panel->SetContent(VerticalBox.ToSharedRef());
+	PlayBorder = Panel;
+	return true;
+}
+
+TSharedRef<SWidget> FMinesweeperGame::CreateTileGrid()
+{
+	constexpr double ButtonSizePx = 32.0;
+	constexpr double ButtonImageRelativeSize = 0.78;
+	const FVector2d ButtonSize(ButtonSizePx, ButtonSizePx);
+
+	PlayAreaWidget = SNew(SGridPanel);
 	
 	for (int i = 0; i < Width; i++) {
 		for (int j = 0; j < Height; j++) {
 			FMinesweeperTile* Tile = GetTilePtr(i, j);
+			TSharedPtr<SMineButton> Button;
 			
 			auto Slot = PlayAreaWidget->AddSlot(i, j);
 			Slot
@@ -392,7 +605,7 @@ bool FMinesweeperGame::SetPlayArea(TSharedPtr<SBorder> Panel)
 					.BorderBackgroundColor(FSlateColor(FColorList::Grey))
 					.Padding(0)
 					[
-						SAssignNew(Tile->Button, SMineButton)
+						SAssignNew(Button, SMineButton)
 						.IsEnabled_Raw(Tile, &FMinesweeperTile::IsEnabled)
 						.OnClicked_Raw(Tile, &FMinesweeperTile::OnClicked)
 						.ButtonStyle(&FCoreStyle::Get().GetWidgetStyle<FButtonStyle>("SimpleButton"))
@@ -417,7 +630,7 @@ bool FMinesweeperGame::SetPlayArea(TSharedPtr<SBorder> Panel)
 							.Position(ButtonSize / (2.0 + 1 - ButtonImageRelativeSize))
 							.Size(ButtonSize * ButtonImageRelativeSize)
 							[
-								SAssignNew(Tile->Image, SImage)
+								SNew(SImage)
 								.ColorAndOpacity_Raw(Tile, &FMinesweeperTile::GetColor)
 								.Image_Raw(Tile, &FMinesweeperTile::GetImage)
 							]
@@ -428,7 +641,7 @@ bool FMinesweeperGame::SetPlayArea(TSharedPtr<SBorder> Panel)
 							.Position(ButtonSize / (2.0 + 1 - ButtonImageRelativeSize))
 							.Size(ButtonSize * ButtonImageRelativeSize)
 							[
-								SAssignNew(Tile->Text, STextBlock)
+								SNew(STextBlock)
 								.Text_Raw(Tile, &FMinesweeperTile::GetText)
 								.ColorAndOpacity_Raw(Tile, &FMinesweeperTile::GetColor)
 								.TextStyle(&FSlateStyleRegistry::FindSlateStyle("StateTreeEditorStyle")->GetWidgetStyle<FTextBlockStyle>("StateTree.State.Title"))
@@ -440,30 +653,118 @@ bool FMinesweeperGame::SetPlayArea(TSharedPtr<SBorder> Panel)
 
 			// Not a huge fan of this, but unless I want to write an entire button class for a demo its the only way I know how to get SButton bindings for right click
 			// (without copying & pasting the *entire* class)
-			Tile->Button->OnRightClicked.BindRaw(Tile, &FMinesweeperTile::OnRightClicked);
-
-			// Flattened index
-			const int Index = i + j * Width;
-			
-			// Assign the grid slot to the play area array
-			PlayAreaGridWidgets[Index] = Slot.GetSlot();
+			Button->OnRightClicked.BindRaw(Tile, &FMinesweeperTile::OnRightClicked);
 		}
 	}
 
-	Panel->SetContent(VerticalBox.ToSharedRef());
-	PlayBorder = Panel;
-	return true;
+#if WITH_MINESWEEPER_PERF_HUD
+	// Counted once, the grid never changes shape after this
+	const TFunction<int(const TSharedRef<SWidget>&)> CountWidgets = [&CountWidgets](const TSharedRef<SWidget>& Widget) {
+		int Count = 1;
+		FChildren* Children = Widget->GetChildren();
+		for (int i = 0; i < Children->Num(); i++) {
+			Count += CountWidgets(Children->GetChildAt(i));
+		}
+
+		return Count;
+	};
+
+	TileWidgetCount = CountWidgets(PlayAreaWidget.ToSharedRef()) - 1;
+#endif
+
+	return PlayAreaWidget.ToSharedRef();
+}
+
+TSharedRef<SWidget> FMinesweeperGame::CreateBoardView()
+{
+	// Painted cells instead of widgets, a grid of hundreds of thousands of buttons doesnt lay out in any sane time
+	Pyramid.Initialize(*this);
+
+	return SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			SAssignNew(BoardView, SMinesweeperBoardView)
+			.Game(this)
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding(FMargin(7.0f, 0.0f, 0.0f, 0.0f))
+		.VAlign(VAlign_Top)
+		[
+			SNew(SMinesweeperMinimap)
+			.Game(this)
+			.BoardView(BoardView)
+		];
 }
 
 void FMinesweeperGame::SetState(EMinesweeperGameState State)
 {
 	GameState = State;
 
+	if (IsGameComplete()) {
+		EndTime = FPlatformTime::Seconds();
+	}
+
+	if (GameState == FinishLose) {
+		// Only the mines, never the whole board
+		for (const int Index : MineIndices) {
+			// Not calling the function on purpose. infinite loop
+			Board[Index].IsExposed = true;
+			RecordChange(Index);
+		}
+	}
+}
+
+EActiveTimerReturnType FMinesweeperGame::PollSimulation(double InCurrentTime, float InDeltaTime)
+{
+	if (Simulation->AcquireSnapshot()) {
+		OnSnapshot(Simulation->GetSnapshot());
+	}
+
+	// Only keeps Slate ticking while the simulation still owes us something
+	if (GetDisplay().ProcessedCommands < SubmittedCommands) {
+		return EActiveTimerReturnType::Continue;
+	}
+
+	SimulationTimerHandle.Reset();
+	return EActiveTimerReturnType::Stop;
+}
+
+void FMinesweeperGame::OnSnapshot(const FMinesweeperSnapshot& Snapshot)
+{
+	for (const int Index : Snapshot.ChangedCells) {
+		Pyramid.MarkDirty(Index);
+	}
+
+#if WITH_MINESWEEPER_PERF_HUD
+	if (PerfHud) {
+		PerfHud->EndClickLogic(Snapshot.LogicCycles, Snapshot.ProcessedCommands);
+	}
+#endif
+
+	if (Snapshot.ChangedCells.Num()) {
+		RequestHeatmap();
+	}
+
+	// Arrives a frame or more after the click that decided it, nothing to defer anymore
+	if ((Snapshot.View.State == FinishWin || Snapshot.View.State == FinishLose) && !bResultPresented) {
+		PresentResult();
+	}
+}
+
+void FMinesweeperGame::PresentResult()
+{
+	bResultPresented = true;
+
 	static int TotalPlayCount = 0;
 	TotalPlayCount++;
-	
+
+	const FMinesweeperSnapshot& Snapshot = GetDisplay();
+	const EMinesweeperGameState State = Snapshot.View.State;
+
 	FString Message;
-	switch (GameState) {
+	switch (State) {
 	case FinishWin: {
 		Message = "You've Won!! Congratulations.";
 		break;
@@ -477,60 +778,97 @@ void FMinesweeperGame::SetState(EMinesweeperGameState State)
 		break;
 	}
 	}
-	
-	TArray Buttons = {
-		SMessageDialog::FButton(INVTEXT("OK"))
-	};
 
-	if (GameState == FinishLose) {
-		// FSimpleDelegate RestartDelegate;
-		// RestartDelegate.BindLambda([this] {
-		// 	
-		// });
-		//
-		// Buttons.Add(SMessageDialog::FButton(INVTEXT("Restart"), RestartDelegate));
+	if (State == FinishWin) {
+		const double ThreeBVPerSecond = Snapshot.ElapsedSeconds > 0.0 ? Snapshot.SolvedThreeBV / Snapshot.ElapsedSeconds : 0.0;
+		Message += FString::Printf(L"\n3BV %d in %.1fs, %.2f 3BV/s", ThreeBV, Snapshot.ElapsedSeconds, ThreeBVPerSecond);
+	}
+
+	if (State == FinishLose) {
+		Message += FString::Printf(L"\n3BV %d of %d solved", Snapshot.SolvedThreeBV, ThreeBV);
 	}
 
-	if (TotalPlayCount > 5) {
+	bShowGithub = TotalPlayCount > 5;
+	if (bShowGithub) {
 		Message += L"\nWow, you're having some fun. You should check out my Github!";
-		FSimpleDelegate GithubDelegate;
-		GithubDelegate.BindLambda([] {
-			FString Error;
-			FPlatformProcess::LaunchURL(L"https://github.com/InclementDab/", nullptr, &Error);
-		});
-		
-		Buttons.Add(SMessageDialog::FButton(INVTEXT("Github"), GithubDelegate));
 	}
 
-	if (IsGameComplete()) {
-		if (GameState == FinishLose) {
-			for (int i = 0; i < Width; i++) {
-				for (int j = 0; j < Height; j++) {
-					auto& Tile = GetTile(i, j);
-					if (Tile.IsMine) {
-						// Not calling the function on purpose. infinite loop
-						Tile.IsExposed = true;
-					}
-				}
-			}
-		}
+	ResultMessage = FText::FromString(Message);
+	bShowResult = true;
+}
 
-		FSlateApplication& App = FSlateApplication::Get();
-		if (App.CanAddModalWindow()) {
-			TSharedRef<SMessageDialog> Dialog = SNew(SMessageDialog)
-				.Title(INVTEXT("Thanks for playing!"))
-				.Buttons(Buttons)
-				.Message(FText::FromString(Message));
-
-			// This is forcing the application to run a full frame before showing the modal dialog.
-			// and it is the only thing i've used an LLM for on this project
-			App.Tick();
-			App.PumpMessages();
-			App.Tick();
-			
-			Dialog->ShowModal();
-		}
-	}
+TSharedRef<SWidget> FMinesweeperGame::CreateResultOverlay()
+{
+	return SNew(SBorder)
+		.Visibility_Lambda([this] {
+			return bShowResult ? EVisibility::Visible : EVisibility::Collapsed;
+		})
+		.HAlign(HAlign_Center)
+		.VAlign(VAlign_Center)
+		.BorderImage(FCoreStyle::Get().GetBrush("GenericWhiteBox"))
+		.BorderBackgroundColor(FLinearColor(0.0f, 0.0f, 0.0f, 0.5f))
+		[
+			SNew(SBorder)
+			.Padding(14)
+			[
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(FMargin(0.0f, 0.0f, 0.0f, 7.0f))
+				[
+					SNew(STextBlock)
+					.Text(INVTEXT("Thanks for playing!"))
+					.Font(FCoreStyle::GetDefaultFontStyle("Bold", 14))
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.Text_Lambda([this] {
+						return ResultMessage;
+					})
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.HAlign(HAlign_Right)
+				.Padding(FMargin(0.0f, 7.0f, 0.0f, 0.0f))
+				[
+					SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(FMargin(3.0f, 0.0f, 0.0f, 0.0f))
+					[
+						SNew(SButton)
+						.Text(INVTEXT("Github"))
+						.Visibility_Lambda([this] {
+							return bShowGithub ? EVisibility::Visible : EVisibility::Collapsed;
+						})
+						.OnClicked_Lambda([] {
+							FString Error;
+							FPlatformProcess::LaunchURL(L"https://github.com/InclementDab/", nullptr, &Error);
+							return FReply::Handled();
+						})
+					]
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.Padding(FMargin(3.0f, 0.0f, 0.0f, 0.0f))
+					[
+						// Dismiss to look over the board, the game stays finished until End is pressed
+						SNew(SButton)
+						.Text(INVTEXT("OK"))
+						.OnClicked_Lambda([this] {
+							bShowResult = false;
+							return FReply::Handled();
+						})
+					]
+				]
+			]
+		];
+}
+
+EMinesweeperGameState FMinesweeperGame::GetState() const
+{
+	return GameState;
 }
 
 bool FMinesweeperGame::IsGameComplete() const
@@ -552,80 +890,278 @@ FMinesweeperTile* FMinesweeperGame::GetTilePtr(const int X, const int Y) const
 	return &Board[X + Y * Width];
 }
 
-int FMinesweeperGame::GetMineCountInArea(const FIntPoint Position, const int DistanceFromCenter) const
+int FMinesweeperGame::GetIndex(const FIntPoint Position) const
 {
-	int AreaMineCount = 0;
-	for (int i = Position[0] - DistanceFromCenter; i <= DistanceFromCenter + Position[0]; i++) {
-		for (int j = Position[1] - DistanceFromCenter; j <= DistanceFromCenter + Position[1]; j++) {
-			// Not to care about the center tile
-			if (i == Position[0] && j == Position[1]) {
-				continue;
-			}
+	return Position[0] + Position[1] * Width;
+}
 
-			// cannot be mines outside of map
-			if (i < 0 || i >= Width) {
-				continue;	
-			}
+bool FMinesweeperGame::Reveal(const int Index)
+{
+	if (IsGameComplete() || Board[Index].IsExposed) {
+		return false;
+	}
 
-			if (j < 0 || j >= Height) {
-				continue;
-			}
+	Board[Index].Expose();
+	return true;
+}
+
+bool FMinesweeperGame::ToggleFlag(const int Index)
+{
+	FMinesweeperTile& Tile = Board[Index];
+	if (IsGameComplete() || Tile.IsExposed) {
+		return false;
+	}
+
+	Tile.IsFlagged = !Tile.IsFlagged;
+	OnTileFlagged(&Tile);
+	return true;
+}
+
+bool FMinesweeperGame::Chord(const int Index)
+{
+	return ChordWithLayout(FMinesweeperDynamicLayout { Width, Height }, Index);
+}
+
+bool FMinesweeperGame::HandlePlayerAction(const FMinesweeperAction& Action)
+{
+	if (!Simulation || Action.Index < 0 || Action.Index >= Width * Height) {
+		return false;
+	}
+
+	Simulation->Enqueue(Action);
+	SubmittedCommands++;
+
+#if WITH_MINESWEEPER_PERF_HUD
+	if (PerfHud) {
+		PerfHud->BeginClick(SubmittedCommands);
+	}
+#endif
+
+	if (!SimulationTimerHandle) {
+		SimulationTimerHandle = PlayBorder->RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateRaw(this, &FMinesweeperGame::PollSimulation));
+	}
+
+	return true;
+}
+
+void FMinesweeperGame::SetRecordChanges(const bool bRecord)
+{
+	bRecordChanges = bRecord;
+	RecordedChanges.Reset();
+}
+
+void FMinesweeperGame::ConsumeChanges(TArray<int>& OutCells)
+{
+	OutCells.Append(RecordedChanges);
+	RecordedChanges.Reset();
+}
+
+void FMinesweeperGame::RecordChange(const int Index)
+{
+	if (bRecordChanges) {
+		RecordedChanges.Add(Index);
+	}
+}
+
+const FMinesweeperSnapshot& FMinesweeperGame::GetDisplay() const
+{
+	check(Simulation);
+	return Simulation->GetSnapshot();
+}
+
+uint8 FMinesweeperGame::GetDisplayCell(const int Index) const
+{
+	return GetDisplay().View.Cells[Index];
+}
+
+EMinesweeperGameState FMinesweeperGame::GetDisplayState() const
+{
+	return GetDisplay().View.State;
+}
+
+void FMinesweeperGame::StopSimulation()
+{
+	Simulation.Reset();
+}
+
+bool FMinesweeperGame::ApplyAction(const FMinesweeperAction& Action)
+{
+	if (Action.Index < 0 || Action.Index >= Width * Height) {
+		return false;
+	}
+
+	switch (Action.Type) {
+	case EMinesweeperActionType::Reveal: return Reveal(Action.Index);
+	case EMinesweeperActionType::Flag: return ToggleFlag(Action.Index);
+	case EMinesweeperActionType::Chord: return Chord(Action.Index);
+	default: return false;
+	}
+}
+
+void FMinesweeperGame::GetView(FMinesweeperView& OutView) const
+{
+	const int CellCount = Width * Height;
 	
-			AreaMineCount += GetTile(i, j).IsMine;
-		}
+	OutView.Width = Width;
+	OutView.Height = Height;
+	OutView.MineCount = MineCount;
+	OutView.FlagsPlaced = FlagsPlaced;
+	OutView.State = GameState;
+	OutView.Cells.SetNumUninitialized(CellCount);
+	
+	for (int Index = 0; Index < CellCount; Index++) {
+		OutView.Cells[Index] = GetViewCell(Index);
+	}
+}
+
+uint8 FMinesweeperGame::GetViewCell(const int Index) const
+{
+	const FMinesweeperTile& Tile = Board[Index];
+	if (!Tile.IsExposed) {
+		return static_cast<uint8>(Tile.IsFlagged ? EMinesweeperCell::Flagged : EMinesweeperCell::Hidden);
 	}
 
-	return AreaMineCount;
+	if (Tile.IsMine) {
+		return static_cast<uint8>(EMinesweeperCell::Mine);
+	}
+	
+	return static_cast<uint8>(Tile.MinesInArea);
 }
 
-void FMinesweeperGame::UnlockSurroundingTilesIfEmpty(const FIntPoint Position, const int DistanceFromCenter, TArray<FIntPoint>& CheckedPositions)
+void FMinesweeperGame::SetHeatmapEnabled(const bool bEnabled)
 {
-	CheckedPositions.Add(Position);
+	if (bEnabled == IsHeatmapEnabled()) {
+		return;
+	}
 
-	if (GetMineCountInArea(Position, DistanceFromCenter)) {
+	if (!bEnabled) {
+		HeatmapSolver->Cancel();
+		HeatmapSolver.Reset();
 		return;
 	}
 
-	// slow. but functional. wont check things twice but will require a O(n) array look up at each iteration
-	// making this O(nlogn) i think
-	for (int i = Position[0] - DistanceFromCenter; i <= DistanceFromCenter + Position[0]; i++) {
-		for (int j = Position[1] - DistanceFromCenter; j <= DistanceFromCenter + Position[1]; j++) {
-			if (i == Position[0] && j == Position[1]) {
-				continue;
-			}
-			
-			FIntPoint TilePosition = { i, j };
-			// cannot be mines outside of map
-			if (TilePosition[0] < 0 || TilePosition[0] >= Width) {
-				continue;	
-			}
+	HeatmapSolver = MakeShared<FMinesweeperHeatmapSolver, ESPMode::ThreadSafe>();
+	RequestHeatmap();
+}
 
-			if (TilePosition[1] < 0 || TilePosition[1] >= Height) {
-				continue;
-			}
-			
-			if (CheckedPositions.Contains(TilePosition)) {
-				continue;
-			}
-			
-			const int Count = GetMineCountInArea(TilePosition, DistanceFromCenter);
-			if (!Count) {
-				UnlockSurroundingTilesIfEmpty(TilePosition, DistanceFromCenter, CheckedPositions);
-			}			
-			
-            auto& Tile = GetTile(TilePosition[0], TilePosition[1]);
-            Tile.Expose();
-		}
+bool FMinesweeperGame::IsHeatmapEnabled() const
+{
+	return HeatmapSolver.IsValid();
+}
+
+void FMinesweeperGame::RequestHeatmap()
+{
+	if (!HeatmapSolver) {
+		return;
+	}
+
+	const FMinesweeperSnapshot& Display = GetDisplay();
+	if (Display.View.State == FinishWin || Display.View.State == FinishLose) {
+		HeatmapSolver->Cancel();
+		return;
+	}
+
+	// The worker gets its own copy, the front snapshot gets swapped out under it
+	FMinesweeperView Snapshot = Display.View;
+	HeatmapSolver->Request(MoveTemp(Snapshot));
+}
+
+float FMinesweeperGame::GetMineProbability(const int Index) const
+{
+	if (!HeatmapSolver || GetDisplayState() == FinishWin || GetDisplayState() == FinishLose) {
+		return -1.0f;
+	}
+
+	const FMinesweeperHeatmap* Heatmap = HeatmapSolver->Get();
+	return Heatmap ? Heatmap->Probabilities[Index] : -1.0f;
+}
+
+FMinesweeperLodPyramid& FMinesweeperGame::GetPyramid()
+{
+	return Pyramid;
+}
+
+const FMinesweeperLodPyramid& FMinesweeperGame::GetPyramid() const
+{
+	return Pyramid;
+}
+
+int FMinesweeperGame::GetThreeBV() const
+{
+	return ThreeBV;
+}
+
+int FMinesweeperGame::GetSolvedThreeBV() const
+{
+	return SolvedThreeBV;
+}
+
+double FMinesweeperGame::GetElapsedSeconds() const
+{
+	if (!StartTime) {
+		return 0.0;
+	}
+
+	return (EndTime ? EndTime : FPlatformTime::Seconds()) - StartTime;
+}
+
+#if WITH_MINESWEEPER_PERF_HUD
+SIZE_T FMinesweeperGame::GetAllocatedSize() const
+{
+	SIZE_T Size = Width * Height * sizeof(FMinesweeperTile);
+	Size += MineIndices.GetAllocatedSize() + OpeningLabels.GetAllocatedSize() + OpeningOffsets.GetAllocatedSize() + OpeningTiles.GetAllocatedSize() + OpeningsRevealed.GetAllocatedSize();
+	Size += Pyramid.GetAllocatedSize();
+
+	// Two snapshots worth of cells, their sizes never change once the simulation is up
+	if (Simulation) {
+		Size += 2 * GetDisplay().View.Cells.GetAllocatedSize();
+	}
+	
+	return Size;
+}
+
+int FMinesweeperGame::GetTileWidgetCount() const
+{
+	return TileWidgetCount;
+}
+#endif
+
+void FMinesweeperGame::AnalyzeBoard()
+{
+	const FMinesweeperDynamicLayout Layout { Width, Height };
+	CountNeighborMines(Layout);
+	AnalyzeOpenings(Layout);
+}
+
+void FMinesweeperGame::RevealOpening(const int Label)
+{
+	if (OpeningsRevealed[Label]) {
+		return;
+	}
+
+	// Marked first, the zero tiles in here land back in this function as they get exposed
+	OpeningsRevealed[Label] = true;
+	SolvedThreeBV++;
+
+	for (int i = OpeningOffsets[Label]; i < OpeningOffsets[Label + 1]; i++) {
+		Board[OpeningTiles[i]].Expose();
 	}
 }
 
 void FMinesweeperGame::OnTileExposed(FMinesweeperTile* Tile)
 {
+	const int Index = GetIndex(Tile->Position);
+	
 	SpacesExposed++;
-		
-	// handle distance to mine logic, if we arent a mine
-	if (!Tile->IsMine) {
-		Tile->MinesInArea = GetMineCountInArea(Tile->Position, 1);
+	RecordChange(Index);
+	
+	// Tiles keep exposing while an opening finishes, the game is already decided
+	if (IsGameComplete()) {
+		return;
+	}
+
+	if (!StartTime) {
+		StartTime = FPlatformTime::Seconds();
 	}
 	
 	// Womp womp
@@ -634,8 +1170,24 @@ void FMinesweeperGame::OnTileExposed(FMinesweeperTile* Tile)
 		return;
 	}
 
+	const int Label = OpeningLabels[Index];
+	if (Label == IsolatedTile) {
+		SolvedThreeBV++;
+	}
+
+	// Zero tiles take the whole precomputed opening with them
+	if (Label >= 0) {
+		RevealOpening(Label);
+	}
+
 	// You won!!
-	if ((Width * Height - MineCount) <= SpacesExposed) {
+	if (!IsGameComplete() && (Width * Height - MineCount) <= SpacesExposed) {
 		SetState(FinishWin);
 	}
 }
+
+void FMinesweeperGame::OnTileFlagged(FMinesweeperTile* Tile)
+{
+	FlagsPlaced += Tile->IsFlagged ? 1 : -1;
+	RecordChange(GetIndex(Tile->Position));
+}
@@ -3,6 +3,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MinesweeperLodPyramid.h"
+#include "Tasks/Task.h"
+
+// In window frame and click timing overlay, see SMinesweeperPerfHud.h
+#define WITH_MINESWEEPER_PERF_HUD (!UE_BUILD_SHIPPING)
+
+class FMinesweeperHeatmapSolver;
+class FMinesweeperSimulation;
+class SMinesweeperPerfHud;
+struct FMinesweeperSnapshot;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogMinesweeper, Log, All);
+
+class SMinesweeperBoardView;
 
 class SMineButton: public SButton
 {
@@ -21,26 +35,159 @@ enum EMinesweeperGameState
 	FinishLose
 };
 
+namespace Minesweeper
+{
+	// Calls Functor with the flat index of every neighbor inside a Width x Height board
+	template<typename FunctorType>
+	void ForEachNeighbor(const int Width, const int Height, const int Index, FunctorType&& Functor)
+	{
+		const int X = Index % Width;
+		const int Y = Index / Width;
+		for (int j = FMath::Max(Y - 1, 0); j <= FMath::Min(Y + 1, Height - 1); j++) {
+			for (int i = FMath::Max(X - 1, 0); i <= FMath::Min(X + 1, Width - 1); i++) {
+				if (i != X || j != Y) {
+					Functor(i + j * Width);
+				}
+			}
+		}
+	}
+}
+
+// Anything a tile can show a player that isnt an exposed count (0-8)
+enum class EMinesweeperCell : uint8
+{
+	Hidden = 9,
+	Flagged = 10,
+	Mine = 11
+};
+
+enum class EMinesweeperActionType : uint8
+{
+	Reveal,
+	Flag,
+	Chord
+};
+
+struct FMinesweeperAction
+{
+	EMinesweeperActionType Type = EMinesweeperActionType::Reveal;
+	int Index = INDEX_NONE;
+};
+
+// The board as a player sees it, one byte per tile. Never contains a mine that hasnt been exposed
+struct FMinesweeperView
+{
+	int Width = 0, Height = 0, MineCount = 0;
+	int FlagsPlaced = 0;
+	EMinesweeperGameState State = None;
+	TArray<uint8> Cells;
+
+	bool IsExposed(const int Index) const
+	{
+		return Cells[Index] < static_cast<uint8>(EMinesweeperCell::Hidden);
+	}
+
+	bool IsHidden(const int Index) const
+	{
+		return Cells[Index] == static_cast<uint8>(EMinesweeperCell::Hidden);
+	}
+
+	bool IsFlagged(const int Index) const
+	{
+		return Cells[Index] == static_cast<uint8>(EMinesweeperCell::Flagged);
+	}
+
+	template<typename FunctorType>
+	void ForEachNeighbor(const int Index, FunctorType&& Functor) const
+	{
+		Minesweeper::ForEachNeighbor(Width, Height, Index, Forward<FunctorType>(Functor));
+	}
+};
+
 class FMinesweeperGame
 {
 public:
 	FMinesweeperGame() = default;
 	FMinesweeperGame(const int InWidth, const int InHeight, const int InMineCount);
+	FMinesweeperGame(const int InWidth, const int InHeight, const int InMineCount, const int Seed);
 	virtual ~FMinesweeperGame();
 
+	// Picks the fixed size board for the presets, anything else gets the dynamic one
+	static TSharedPtr<FMinesweeperGame> Create(const int InWidth, const int InHeight, const int InMineCount);
+	static TSharedPtr<FMinesweeperGame> Create(const int InWidth, const int InHeight, const int InMineCount, const int Seed);
+
+	// Same seed, same minefield. Shared so anything simulating boards outside of a game places mines identically
+	static void GenerateMines(const int InWidth, const int InHeight, const int InMineCount, const int Seed, TArray<int>& OutMineIndices);
+
+	// Seed for games that dont ask for a particular board. Full 32 bits, FMath::Rand alone only has 15 on some platforms
+	static int MakeSeed();
+
+	// Player actions, false when nothing changed
+	bool Reveal(const int Index);
+	bool ToggleFlag(const int Index);
+	virtual bool Chord(const int Index);
+	bool ApplyAction(const FMinesweeperAction& Action);
+
+	// Actions coming from the UI, queued for the simulation thread. Anything that follows from them shows up with the next snapshot
+	bool HandlePlayerAction(const FMinesweeperAction& Action);
+
+	// Tiles touched since the last call, only kept track of while recording
+	void SetRecordChanges(const bool bRecord);
+	void ConsumeChanges(TArray<int>& OutCells);
+
+	// Game thread. The board as of the last snapshot the simulation handed over, all drawing goes through these
+	const FMinesweeperSnapshot& GetDisplay() const;
+	uint8 GetDisplayCell(const int Index) const;
+	EMinesweeperGameState GetDisplayState() const;
+
+	// Fills OutView with what a player is allowed to see
+	void GetView(FMinesweeperView& OutView) const;
+	uint8 GetViewCell(const int Index) const;
+
+	// Optional mine probability tint, recomputed off the game thread after every player action
+	void SetHeatmapEnabled(const bool bEnabled);
+	bool IsHeatmapEnabled() const;
+	void RequestHeatmap();
+
+	// Negative when there is nothing to show for the tile
+	float GetMineProbability(const int Index) const;
+
 	bool SetPlayArea(TSharedPtr<SBorder> Panel);
 	void SetState(EMinesweeperGameState State);
+	EMinesweeperGameState GetState() const;
 	bool IsGameComplete() const;
 	
 	class FMinesweeperTile& GetTile(const int X, const int Y) const;
 	FMinesweeperTile* GetTilePtr(const int X, const int Y) const;
+	int GetIndex(const FIntPoint Position) const;
+
+	FMinesweeperLodPyramid& GetPyramid();
+	const FMinesweeperLodPyramid& GetPyramid() const;
 	
-	// Returns mine count in nxn space around position
-	int GetMineCountInArea(const FIntPoint Position, const int DistanceFromCenter) const;
+	// Bechtel's Board Benchmark Value, minimum clicks needed to clear the board without flagging
+	int GetThreeBV() const;
+
+	// Rules side, once a simulation runs the UI gets these from its snapshot instead
+	int GetSolvedThreeBV() const;
+	double GetElapsedSeconds() const;
+
+#if WITH_MINESWEEPER_PERF_HUD
+	// Tiles, derived tables and pyramid, not counting widgets
+	SIZE_T GetAllocatedSize() const;
+	int GetTileWidgetCount() const;
+#endif
 
-	void UnlockSurroundingTilesIfEmpty(const FIntPoint Position, const int DistanceFromCenter, TArray<FIntPoint>& CheckedPositions);
+	// Exposes the opening and its numbered border in one go
+	void RevealOpening(const int Label);
+
+	template<typename FunctorType>
+	void ForEachNeighbor(const int Index, FunctorType&& Functor) const
+	{
+		Minesweeper::ForEachNeighbor(Width, Height, Index, Forward<FunctorType>(Functor));
+	}
 
 	void OnTileExposed(FMinesweeperTile* Tile);
+	void OnTileFlagged(FMinesweeperTile* Tile);
 
 	// User facing statistics
 	int FlagsPlaced = 0;
@@ -48,16 +195,84 @@ public:
 	int Width = 0, Height = 0, MineCount = 0;
 	
 protected:
+	// For subclasses that bring their own tile storage, they have to call Initialize once Board points at it
+	FMinesweeperGame(const int InWidth, const int InHeight, const int InMineCount, FMinesweeperTile* InBoard);
+
+	void Initialize(const int Seed);
+	virtual void PlaceMines();
+
+	// Rules written once against a board layout, see MinesweeperBoardLayout.h
+	template<typename LayoutType>
+	void CountNeighborMines(const LayoutType& Layout);
+	template<typename LayoutType>
+	void AnalyzeOpenings(const LayoutType& Layout);
+	template<typename LayoutType>
+	bool ChordWithLayout(const LayoutType& Layout, const int Index);
+	
+	TSharedRef<SWidget> CreateTileGrid();
+	TSharedRef<SWidget> CreateBoardView();
+	TSharedRef<SWidget> CreateResultOverlay();
+
+	EActiveTimerReturnType PollSimulation(double InCurrentTime, float InDeltaTime);
+	void OnSnapshot(const FMinesweeperSnapshot& Snapshot);
+	void PresentResult();
+
+	// Has to happen before any subclass storage goes away, the simulation thread could still be in it
+	void StopSimulation();
+
+	void RecordChange(const int Index);
+
+	// Counts, openings and 3BV, done once after the mines are placed
+	virtual void AnalyzeBoard();
+
 	FMinesweeperTile* Board = nullptr;
+	bool bOwnsBoard = false;
+
+	bool bRecordChanges = false;
+	TArray<int> RecordedChanges;
+
+	// Flat indices of every mine, filled during generation
+	TArray<int> MineIndices;
 
-	// 8x8 for beginner, 10 mines
-	// 16x16 for intermediate 40 mines
-	// 32x16 for expert 99 mines
-	// 32x32 for impossible 170 mines
+	// Opening label per tile, and the tiles of opening N in OpeningTiles[OpeningOffsets[N]..OpeningOffsets[N + 1]]
+	// Numbers that dont touch any opening are IsolatedTile, everything else outside an opening INDEX_NONE
+	static constexpr int IsolatedTile = -2;
+	TArray<int> OpeningLabels;
+	TArray<int> OpeningOffsets;
+	TArray<int> OpeningTiles;
+	TBitArray<> OpeningsRevealed;
+
+	int ThreeBV = 0;
+	int SolvedThreeBV = 0;
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	// Anything bigger than this per side gets the pan/zoom view instead of a widget per tile
+	static constexpr int MaxWidgetGridSize = 64;
 	
 	TSharedPtr<SBorder> PlayBorder;
 	TSharedPtr<SGridPanel> PlayAreaWidget;
-	SGridPanel::FSlot** PlayAreaGridWidgets = nullptr;
+
+	TSharedPtr<SMinesweeperBoardView> BoardView;
+	FMinesweeperLodPyramid Pyramid;
+
+	TSharedPtr<FMinesweeperHeatmapSolver, ESPMode::ThreadSafe> HeatmapSolver;
+
+	// Only exists once there is a play area, headless games run their rules on the calling thread
+	TUniquePtr<FMinesweeperSimulation> Simulation;
+	TSharedPtr<FActiveTimerHandle> SimulationTimerHandle;
+	uint64 SubmittedCommands = 0;
+
+#if WITH_MINESWEEPER_PERF_HUD
+	TSharedPtr<SMinesweeperPerfHud> PerfHud;
+	int TileWidgetCount = 0;
+	bool bShowPerfHud = false;
+#endif
+	
+	FText ResultMessage;
+	bool bResultPresented = false;
+	bool bShowResult = false;
+	bool bShowGithub = false;
 	
 	EMinesweeperGameState GameState = None;
 };
@@ -73,25 +288,11 @@ public:
 	bool IsExposed = false; // User has clicked this mine
 	bool IsFlagged = false; // User has flagged this as a danger
 
-	int MinesInArea = 0; // Validated when clicked
-	
-	TSharedPtr<SMineButton> Button;
-	TSharedPtr<SImage> Image;
-	TSharedPtr<STextBlock> Text;
+	int MinesInArea = 0; // Counted once the board is generated
 
 	FReply OnRightClicked()
 	{
-		if (Game->IsGameComplete()) {
-			return FReply::Handled();
-		}
-		
-		if (IsExposed) {
-			return FReply::Handled();
-		}
-		
-		IsFlagged = !IsFlagged;
-		Game->FlagsPlaced += IsFlagged ? 1 : -1;
-		
+		Game->HandlePlayerAction({ EMinesweeperActionType::Flag, Game->GetIndex(Position) });
 		return FReply::Handled();
 	}
 
@@ -102,45 +303,52 @@ public:
 		}
 		
 		IsExposed = true;
+		
+		// A flag on a tile that turned out safe means nothing anymore
+		if (IsFlagged) {
+			IsFlagged = false;
+			Game->OnTileFlagged(this);
+		}
+		
 		Game->OnTileExposed(this);
 	}
 	
 	FReply OnClicked()
 	{
-		if (Game->IsGameComplete()) {
-			return FReply::Handled();
-		}
-		
-		Expose();
-
-		if (!IsMine) {			
-			// Could be two functions to clean up but im not trying *that* hard
-			TArray<FIntPoint> CheckedPositions;
-			Game->UnlockSurroundingTilesIfEmpty(Position, 1, CheckedPositions);
-		}
-		
+		// Zero tiles open up the rest of their region from in here
+		Game->HandlePlayerAction({ EMinesweeperActionType::Reveal, Game->GetIndex(Position) });
 		return FReply::Handled();
 	}
 
+	// Everything below is drawing and reads the last snapshot, the fields above belong to the simulation
+	EMinesweeperCell GetDisplayCell() const
+	{
+		return static_cast<EMinesweeperCell>(Game->GetDisplayCell(Game->GetIndex(Position)));
+	}
+
+	int GetDisplayCount() const
+	{
+		const uint8 Cell = Game->GetDisplayCell(Game->GetIndex(Position));
+		return Cell < static_cast<uint8>(EMinesweeperCell::Hidden) ? Cell : 0;
+	}
+	
 	bool IsEnabled() const
 	{
-		return !IsExposed;
+		const EMinesweeperCell Cell = GetDisplayCell();
+		return Cell == EMinesweeperCell::Hidden || Cell == EMinesweeperCell::Flagged;
 	}
 	
 	const FSlateBrush* GetImage() const
 	{
-		if (!IsExposed) {
-			if (IsFlagged) {
-				// flagged
-				return FSlateIcon(FName("EditorStyle"), "FontEditor.Tabs.Preview").GetIcon();
-				//return FSlateIcon(FName("EditorStyle"), "ShowFlagsMenu.Navigation").GetIcon();
-			}
-			
-			return nullptr;
+		const EMinesweeperCell Cell = GetDisplayCell();
+		if (Cell == EMinesweeperCell::Flagged) {
+			// flagged
+			return FSlateIcon(FName("EditorStyle"), "FontEditor.Tabs.Preview").GetIcon();
+			//return FSlateIcon(FName("EditorStyle"), "ShowFlagsMenu.Navigation").GetIcon();
 		}
 		
 		// death
-		if (IsMine) {
+		if (Cell == EMinesweeperCell::Mine) {
 			return FSlateIcon(FName("EditorStyle"), "ShowFlagsMenu.Collision").GetIcon();
 		}
 		
@@ -150,17 +358,9 @@ public:
 	// Returns text for icon
 	FText GetText() const
 	{
-		if (IsMine) {
-			return INVTEXT("");
-		}
-		
-		if (IsExposed) {
-			// Expose the number here
-			if (MinesInArea) {
-				return FText::FromString(FString::FormatAsNumber(MinesInArea));
-			}
-			
-			return INVTEXT("");
+		// Expose the number here
+		if (const int Count = GetDisplayCount()) {
+			return FText::FromString(FString::FormatAsNumber(Count));
 		}
 		
 		return INVTEXT("");
@@ -168,38 +368,42 @@ public:
 
 	FSlateColor GetColor() const
 	{
-		if (IsFlagged) {
+		const EMinesweeperCell Cell = GetDisplayCell();
+		if (Cell == EMinesweeperCell::Flagged) {
 			return FColorList::Red;
 		}
 
-		if (IsExposed && IsMine) {
+		if (Cell == EMinesweeperCell::Mine) {
 			return FColor::Black;
 		}
 
-		if (IsExposed && !IsMine) {
-			switch (MinesInArea) {
-			case 1: return FColorList::NeonBlue;
-			case 2: return FColorList::Green;
-			case 3: return FColorList::Red;
-			case 4: return FColorList::Violet;
-			case 5: return FColorList::Brown;
-			case 6: return FColorList::Orange;
-			case 7: return FColorList::DarkPurple;
-			case 8: return FColorList::Gold;
-			default: return FColorList::White;
-			}
+		switch (GetDisplayCount()) {
+		case 1: return FColorList::NeonBlue;
+		case 2: return FColorList::Green;
+		case 3: return FColorList::Red;
+		case 4: return FColorList::Violet;
+		case 5: return FColorList::Brown;
+		case 6: return FColorList::Orange;
+		case 7: return FColorList::DarkPurple;
+		case 8: return FColorList::Gold;
+		default: return FColorList::White;
 		}
-
-		return FColorList::White;
 	}
 
 	FSlateColor GetBackgroundColor() const
 	{
-		if (!IsExposed) {
+		if (IsEnabled()) {
+			const float Probability = Game->GetMineProbability(Game->GetIndex(Position));
+			if (Probability >= 0.0f) {
+				// Green for safe through to red for certain death, kept dim so flags and numbers still read
+				const FLinearColor Heat = FMath::Lerp(FLinearColor(FColorList::ForestGreen), FLinearColor(FColorList::Red), Probability);
+				return FMath::Lerp(FLinearColor(FColorList::DimGrey), Heat, 0.6f);
+			}
+			
 			return FColorList::DimGrey;	
 		}
 
-		if (IsMine) {
+		if (GetDisplayCell() == EMinesweeperCell::Mine) {
 			return FColor::Red;
 		}
 	
@@ -218,5 +422,8 @@ class FGeoTechMinesweeperModule: public IModuleInterface
 
 	TSharedPtr<SBorder> GameArea;
 	TSharedPtr<FMinesweeperGame> Minesweeper;
+
+	// Mines, counts and openings get worked out off the game thread, big boards take a moment
+	UE::Tasks::TTask<TSharedPtr<FMinesweeperGame>> PendingGame;
 };
 
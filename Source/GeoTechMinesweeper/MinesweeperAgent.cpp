@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperAgent.h"
+
+FString FRandomMinesweeperAgent::GetName() const
+{
+	return TEXT("Random");
+}
+
+void FRandomMinesweeperAgent::BeginGame(const FMinesweeperView& View, const int Seed)
+{
+	Stream.Initialize(Seed);
+}
+
+FMinesweeperAction FRandomMinesweeperAgent::Decide(const FMinesweeperView& View)
+{
+	return Guess(View);
+}
+
+FMinesweeperAction FRandomMinesweeperAgent::Guess(const FMinesweeperView& View)
+{
+	Candidates.Reset();
+	for (int Index = 0; Index < View.Cells.Num(); Index++) {
+		if (View.IsHidden(Index)) {
+			Candidates.Add(Index);
+		}
+	}
+
+	FMinesweeperAction Action;
+	if (Candidates.Num()) {
+		Action.Index = Candidates[Stream.RandRange(0, Candidates.Num() - 1)];
+	}
+
+	return Action;
+}
+
+FString FSinglePointMinesweeperAgent::GetName() const
+{
+	return TEXT("SinglePoint");
+}
+
+FMinesweeperAction FSinglePointMinesweeperAgent::Decide(const FMinesweeperView& View)
+{
+	for (int Index = 0; Index < View.Cells.Num(); Index++) {
+		if (!View.IsExposed(Index) || !View.Cells[Index]) {
+			continue;
+		}
+
+		int Hidden = 0, Flagged = 0, FirstHidden = INDEX_NONE;
+		View.ForEachNeighbor(Index, [&](const int Neighbor) {
+			if (View.IsFlagged(Neighbor)) {
+				Flagged++;
+			}
+
+			if (View.IsHidden(Neighbor)) {
+				FirstHidden = Hidden++ ? FirstHidden : Neighbor;
+			}
+		});
+
+		if (!Hidden) {
+			continue;
+		}
+
+		// Every hidden neighbor has to be a mine
+		if (Flagged + Hidden == View.Cells[Index]) {
+			return { EMinesweeperActionType::Flag, FirstHidden };
+		}
+
+		// Every mine is already flagged, the rest is safe
+		if (Flagged == View.Cells[Index]) {
+			return { EMinesweeperActionType::Chord, Index };
+		}
+	}
+
+	return Guess(View);
+}
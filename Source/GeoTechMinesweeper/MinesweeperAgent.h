@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GeoTechMinesweeper.h"
+
+// Plays a game from the player's side of the board only, it never gets to see the game itself
+class IMinesweeperAgent
+{
+public:
+	virtual ~IMinesweeperAgent() = default;
+
+	virtual FString GetName() const = 0;
+
+	// Called before the first decision of every game. Seed is for the agent's own randomness so runs repeat
+	virtual void BeginGame(const FMinesweeperView& View, const int Seed) {}
+
+	virtual FMinesweeperAction Decide(const FMinesweeperView& View) = 0;
+};
+
+// Reveals hidden tiles at random, the baseline anything else has to beat
+class FRandomMinesweeperAgent: public IMinesweeperAgent
+{
+public:
+	virtual FString GetName() const override;
+	virtual void BeginGame(const FMinesweeperView& View, const int Seed) override;
+	virtual FMinesweeperAction Decide(const FMinesweeperView& View) override;
+
+protected:
+	FMinesweeperAction Guess(const FMinesweeperView& View);
+
+	FRandomStream Stream;
+	TArray<int> Candidates;
+};
+
+// Single point deduction. A number that needs every hidden neighbor to be a mine flags them,
+// a number with all of its mines flagged gets chorded, and anything else falls back to a guess
+class FSinglePointMinesweeperAgent: public FRandomMinesweeperAgent
+{
+public:
+	virtual FString GetName() const override;
+	virtual FMinesweeperAction Decide(const FMinesweeperView& View) override;
+};
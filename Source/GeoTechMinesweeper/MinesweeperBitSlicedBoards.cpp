@@ -0,0 +1,220 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperBitSlicedBoards.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+namespace MinesweeperBitSliced
+{
+	struct FSettings
+	{
+		int Width = 16, Height = 16, MineCount = 40;
+		int FirstSeed = 1;
+		int Clicks = 32;
+	};
+
+	FSettings ParseSettings(const TArray<FString>& Args, const int FirstArg)
+	{
+		FSettings Settings;
+		Settings.Width = Args.IsValidIndex(FirstArg) ? FMath::Clamp(FCString::Atoi(*Args[FirstArg]), 1, 4096) : Settings.Width;
+		Settings.Height = Args.IsValidIndex(FirstArg + 1) ? FMath::Clamp(FCString::Atoi(*Args[FirstArg + 1]), 1, 4096) : Settings.Height;
+		Settings.MineCount = Args.IsValidIndex(FirstArg + 2) ? FMath::Clamp(FCString::Atoi(*Args[FirstArg + 2]), 1, Settings.Width * Settings.Height) : Settings.MineCount;
+		Settings.Clicks = Args.IsValidIndex(FirstArg + 3) ? FMath::Max(1, FCString::Atoi(*Args[FirstArg + 3])) : Settings.Clicks;
+		return Settings;
+	}
+
+	// Center first, like a person would, then seeded spots. Every board gets the same ones
+	TArray<int> MakeClicks(const FSettings& Settings, const int Seed)
+	{
+		FRandomStream Stream(Seed);
+
+		TArray<int> Clicks;
+		Clicks.Add(Settings.Width / 2 + Settings.Height / 2 * Settings.Width);
+		while (Clicks.Num() < Settings.Clicks) {
+			Clicks.Add(Stream.RandRange(0, Settings.Width * Settings.Height - 1));
+		}
+
+		return Clicks;
+	}
+
+	// Plays every board of the batch through the scalar game as well and compares tile for tile after each click
+	template<int InWords>
+	bool CrossCheck(const FSettings& Settings, const int FirstSeed, const TArray<int>& Clicks, FString& OutError)
+	{
+		using FBoards = TMinesweeperBitSlicedBoards<InWords>;
+
+		FBoards Boards;
+		Boards.Initialize(Settings.Width, Settings.Height, Settings.MineCount, FirstSeed);
+
+		TArray<TSharedPtr<FMinesweeperGame>> Games;
+		for (int Board = 0; Board < FBoards::BoardCount; Board++) {
+			Games.Add(FMinesweeperGame::Create(Settings.Width, Settings.Height, Settings.MineCount, FirstSeed + Board));
+		}
+
+		const int CellCount = Settings.Width * Settings.Height;
+		const auto Compare = [&](const int Step) {
+			for (int Board = 0; Board < FBoards::BoardCount; Board++) {
+				const FMinesweeperGame& Game = *Games[Board];
+				if (Game.GetState() != Boards.GetState(Board)) {
+					OutError = FString::Printf(TEXT("seed %d step %d: state %d, bit sliced %d"), FirstSeed + Board, Step, Game.GetState(), Boards.GetState(Board));
+					return false;
+				}
+
+				for (int Index = 0; Index < CellCount; Index++) {
+					const FMinesweeperTile& Tile = Game.GetTile(Index % Settings.Width, Index / Settings.Width);
+					if (Tile.IsMine != Boards.IsMine(Board, Index) || (!Tile.IsMine && Tile.MinesInArea != Boards.GetNeighborMines(Board, Index))) {
+						OutError = FString::Printf(TEXT("seed %d tile %d: mine %d count %d, bit sliced mine %d count %d"), FirstSeed + Board, Index, Tile.IsMine, Tile.MinesInArea, Boards.IsMine(Board, Index), Boards.GetNeighborMines(Board, Index));
+						return false;
+					}
+
+					if (Game.GetViewCell(Index) != Boards.GetViewCell(Board, Index)) {
+						OutError = FString::Printf(TEXT("seed %d step %d tile %d: cell %d, bit sliced %d"), FirstSeed + Board, Step, Index, Game.GetViewCell(Index), Boards.GetViewCell(Board, Index));
+						return false;
+					}
+				}
+			}
+
+			return true;
+		};
+
+		if (!Compare(0)) {
+			return false;
+		}
+
+		for (int Step = 0; Step < Clicks.Num(); Step++) {
+			Boards.Reveal(Clicks[Step]);
+			for (const TSharedPtr<FMinesweeperGame>& Game : Games) {
+				Game->Reveal(Clicks[Step]);
+			}
+
+			if (!Compare(Step + 1)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Batches alternate between both lane widths, a mistake in the multi word ops would only show up in the wide one
+	bool Verify(const FSettings& Settings, const int Batches, FString& OutError)
+	{
+		for (int Batch = 0; Batch < Batches; Batch++) {
+			const int FirstSeed = Settings.FirstSeed + Batch * FMinesweeperBitSlicedBoards256::BoardCount;
+			const TArray<int> Clicks = MakeClicks(Settings, FirstSeed);
+
+			const bool bPassed = Batch % 2 ? CrossCheck<1>(Settings, FirstSeed, Clicks, OutError) : CrossCheck<4>(Settings, FirstSeed, Clicks, OutError);
+			if (!bPassed) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperBitSlicedCrossCheckTest, "GeoTechMinesweeper.BitSliced.CrossCheck", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMinesweeperBitSlicedCrossCheckTest::RunTest(const FString& Parameters)
+{
+	using namespace MinesweeperBitSliced;
+
+	// Fixed seeds and clicks so a failure always reproduces. The presets, a board too narrow for a full neighborhood and one
+	// dense enough that most boards lose on the first click
+	const FSettings Cases[] = {
+		{ 9, 9, 10, 1, 32 },
+		{ 16, 16, 40, 1001, 32 },
+		{ 30, 16, 99, 2001, 48 },
+		{ 1, 24, 4, 3001, 16 },
+		{ 8, 8, 40, 4001, 16 },
+	};
+
+	for (const FSettings& Settings : Cases) {
+		FString Error;
+		if (!Verify(Settings, 2, Error)) {
+			AddError(FString::Printf(TEXT("%dx%d with %d mines: %s"), Settings.Width, Settings.Height, Settings.MineCount, *Error));
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
+
+static FAutoConsoleCommand MinesweeperBitSlicedVerifyCommand(
+	TEXT("Minesweeper.BitSliced.Verify"),
+	TEXT("Plays the same seeded boards and clicks through the bit sliced kernel and the scalar game, stops at the first tile that differs. Minesweeper.BitSliced.Verify [Batches=8] [Width=16] [Height=16] [Mines=40] [Clicks=32]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		using namespace MinesweeperBitSliced;
+
+		const int Batches = Args.IsValidIndex(0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 8;
+		const FSettings Settings = ParseSettings(Args, 1);
+
+		FString Error;
+		if (!Verify(Settings, Batches, Error)) {
+			UE_LOG(LogMinesweeper, Error, TEXT("Bit sliced boards disagree with the scalar game, %s"), *Error);
+			return;
+		}
+
+		UE_LOG(LogMinesweeper, Display, TEXT("Bit sliced boards match the scalar game on %d batches of %dx%d with %d mines, %d clicks each"), Batches, Settings.Width, Settings.Height, Settings.MineCount, Settings.Clicks);
+	}));
+
+static FAutoConsoleCommand MinesweeperBitSlicedBenchmarkCommand(
+	TEXT("Minesweeper.BitSliced.Benchmark"),
+	TEXT("Boards per second through the scalar game and the 256 lane bit sliced kernel, same boards and clicks, one thread each. Minesweeper.BitSliced.Benchmark [Boards=16384] [Width=16] [Height=16] [Mines=40] [Clicks=32]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		using namespace MinesweeperBitSliced;
+
+		const int Batches = FMath::DivideAndRoundUp(Args.IsValidIndex(0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 16384, FMinesweeperBitSlicedBoards256::BoardCount);
+		const int BoardCount = Batches * FMinesweeperBitSlicedBoards256::BoardCount;
+		const FSettings Settings = ParseSettings(Args, 1);
+		const TArray<int> Clicks = MakeClicks(Settings, Settings.FirstSeed);
+
+		int ScalarWins = 0;
+		const double ScalarStart = FPlatformTime::Seconds();
+		for (int Board = 0; Board < BoardCount; Board++) {
+			const TSharedPtr<FMinesweeperGame> Game = FMinesweeperGame::Create(Settings.Width, Settings.Height, Settings.MineCount, Settings.FirstSeed + Board);
+			for (const int Click : Clicks) {
+				if (Game->IsGameComplete()) {
+					break;
+				}
+
+				Game->Reveal(Click);
+			}
+
+			ScalarWins += Game->GetState() == FinishWin;
+		}
+
+		const double ScalarSeconds = FPlatformTime::Seconds() - ScalarStart;
+
+		// Initialize is the same scalar mine shuffle as the other side plus the sliced neighbor count, timed apart so the clicks themselves show up too
+		int SlicedWins = 0;
+		double GenerateSeconds = 0.0;
+		const double SlicedStart = FPlatformTime::Seconds();
+		FMinesweeperBitSlicedBoards256 Boards;
+		for (int Batch = 0; Batch < Batches; Batch++) {
+			const double GenerateStart = FPlatformTime::Seconds();
+			Boards.Initialize(Settings.Width, Settings.Height, Settings.MineCount, Settings.FirstSeed + Batch * FMinesweeperBitSlicedBoards256::BoardCount);
+			GenerateSeconds += FPlatformTime::Seconds() - GenerateStart;
+
+			for (const int Click : Clicks) {
+				if (!Boards.IsAnyPlaying()) {
+					break;
+				}
+
+				Boards.Reveal(Click);
+			}
+
+			for (int Board = 0; Board < FMinesweeperBitSlicedBoards256::BoardCount; Board++) {
+				SlicedWins += Boards.GetState(Board) == FinishWin;
+			}
+		}
+
+		const double SlicedSeconds = FPlatformTime::Seconds() - SlicedStart;
+
+		UE_LOG(LogMinesweeper, Display, TEXT("%d boards %dx%d with %d mines, %d clicks"), BoardCount, Settings.Width, Settings.Height, Settings.MineCount, Clicks.Num());
+		UE_LOG(LogMinesweeper, Display, TEXT("Scalar      %10.0f boards/s  (%.3fs, %d won)"), BoardCount / ScalarSeconds, ScalarSeconds, ScalarWins);
+		UE_LOG(LogMinesweeper, Display, TEXT("Bit sliced  %10.0f boards/s  (%.3fs, %d won, %.3fs of it generating mines and counting neighbors)"), BoardCount / SlicedSeconds, SlicedSeconds, SlicedWins, GenerateSeconds);
+		UE_LOG(LogMinesweeper, Display, TEXT("Speedup     %10.1fx"), ScalarSeconds / SlicedSeconds);
+	}));
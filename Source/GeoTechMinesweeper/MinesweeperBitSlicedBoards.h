@@ -0,0 +1,281 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GeoTechMinesweeper.h"
+#include "Containers/StaticArray.h"
+
+// Bit N of every word belongs to board N, so one bitwise op on a cell touches that cell on every board at once
+template<int InWords>
+struct TMinesweeperLanes
+{
+	uint64 Words[InWords] = {};
+
+	FORCEINLINE TMinesweeperLanes operator&(const TMinesweeperLanes& Other) const
+	{
+		TMinesweeperLanes Result;
+		for (int i = 0; i < InWords; i++) {
+			Result.Words[i] = Words[i] & Other.Words[i];
+		}
+
+		return Result;
+	}
+
+	FORCEINLINE TMinesweeperLanes operator|(const TMinesweeperLanes& Other) const
+	{
+		TMinesweeperLanes Result;
+		for (int i = 0; i < InWords; i++) {
+			Result.Words[i] = Words[i] | Other.Words[i];
+		}
+
+		return Result;
+	}
+
+	FORCEINLINE TMinesweeperLanes operator^(const TMinesweeperLanes& Other) const
+	{
+		TMinesweeperLanes Result;
+		for (int i = 0; i < InWords; i++) {
+			Result.Words[i] = Words[i] ^ Other.Words[i];
+		}
+
+		return Result;
+	}
+
+	FORCEINLINE TMinesweeperLanes operator~() const
+	{
+		TMinesweeperLanes Result;
+		for (int i = 0; i < InWords; i++) {
+			Result.Words[i] = ~Words[i];
+		}
+
+		return Result;
+	}
+
+	FORCEINLINE TMinesweeperLanes& operator|=(const TMinesweeperLanes& Other)
+	{
+		for (int i = 0; i < InWords; i++) {
+			Words[i] |= Other.Words[i];
+		}
+
+		return *this;
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		uint64 Any = 0;
+		for (int i = 0; i < InWords; i++) {
+			Any |= Words[i];
+		}
+
+		return !Any;
+	}
+
+	FORCEINLINE bool Get(const int Lane) const
+	{
+		return (Words[Lane >> 6] >> (Lane & 63)) & 1;
+	}
+
+	FORCEINLINE void Set(const int Lane)
+	{
+		Words[Lane >> 6] |= uint64(1) << (Lane & 63);
+	}
+};
+
+// Plays the same reveals on 64 * InWords boards of one size in lockstep, board N generated from FirstSeed + N exactly like
+// FMinesweeperGame would. Neighbor counts are bit sliced adders, openings spread as lane masks and every board counts down
+// its hidden safe tiles like SpacesExposed does. Same rules as the scalar game, the GeoTechMinesweeper.BitSliced.CrossCheck test holds it to that
+template<int InWords>
+class TMinesweeperBitSlicedBoards
+{
+public:
+	using FLanes = TMinesweeperLanes<InWords>;
+	static constexpr int BoardCount = InWords * 64;
+
+	void Initialize(const int InWidth, const int InHeight, const int InMineCount, const int FirstSeed)
+	{
+		Width = InWidth;
+		Height = InHeight;
+		MineCount = FMath::Clamp(InMineCount, 1, Width * Height);
+
+		const int CellCount = Width * Height;
+		Mines.SetNumZeroed(CellCount);
+		Zero.SetNumUninitialized(CellCount);
+		Exposed.SetNumZeroed(CellCount);
+		Pending.SetNumZeroed(CellCount);
+		for (TArray<FLanes>& Plane : Counts) {
+			Plane.SetNumUninitialized(CellCount);
+		}
+
+		Won = Lost = FLanes();
+		Worklist.Reset();
+
+		TArray<int> MineIndices;
+		for (int Board = 0; Board < BoardCount; Board++) {
+			FMinesweeperGame::GenerateMines(Width, Height, MineCount, FirstSeed + Board, MineIndices);
+			for (const int Index : MineIndices) {
+				Mines[Index].Set(Board);
+			}
+
+			HiddenSafe[Board] = CellCount - MineIndices.Num();
+		}
+
+		CountNeighbors();
+	}
+
+	// Reveal on every board that is still being played, the same as FMinesweeperGame::Reveal on each of them
+	void Reveal(const int Index)
+	{
+		const FLanes New = ~(Won | Lost) & ~Exposed[Index];
+		if (New.IsEmpty()) {
+			return;
+		}
+
+		Exposed[Index] |= New;
+		CountExposed(New & ~Mines[Index]);
+
+		// A loss shows every mine, same as the scalar game
+		const FLanes Boom = New & Mines[Index];
+		if (!Boom.IsEmpty()) {
+			Lost |= Boom;
+			for (int Cell = 0; Cell < Mines.Num(); Cell++) {
+				Exposed[Cell] |= Mines[Cell] & Boom;
+			}
+		}
+
+		const FLanes Open = New & Zero[Index];
+		if (!Open.IsEmpty()) {
+			Pending[Index] |= Open;
+			Worklist.Add(Index);
+			Expand();
+		}
+	}
+
+	bool IsAnyPlaying() const
+	{
+		return !(~(Won | Lost)).IsEmpty();
+	}
+
+	EMinesweeperGameState GetState(const int Board) const
+	{
+		if (Lost.Get(Board)) {
+			return FinishLose;
+		}
+
+		return Won.Get(Board) ? FinishWin : Playing;
+	}
+
+	int GetNeighborMines(const int Board, const int Index) const
+	{
+		return Counts[0][Index].Get(Board) | Counts[1][Index].Get(Board) << 1 | Counts[2][Index].Get(Board) << 2 | Counts[3][Index].Get(Board) << 3;
+	}
+
+	bool IsMine(const int Board, const int Index) const
+	{
+		return Mines[Index].Get(Board);
+	}
+
+	// Same encoding as FMinesweeperGame::GetViewCell. There is no flagging in here
+	uint8 GetViewCell(const int Board, const int Index) const
+	{
+		if (!Exposed[Index].Get(Board)) {
+			return static_cast<uint8>(EMinesweeperCell::Hidden);
+		}
+
+		if (IsMine(Board, Index)) {
+			return static_cast<uint8>(EMinesweeperCell::Mine);
+		}
+
+		return static_cast<uint8>(GetNeighborMines(Board, Index));
+	}
+
+	int Width = 0, Height = 0, MineCount = 0;
+
+protected:
+	void CountNeighbors()
+	{
+		for (int Index = 0; Index < Mines.Num(); Index++) {
+			// Four bit counter per board, every neighbor goes through a ripple carry add. 8 fits, 1000
+			FLanes Bit0, Bit1, Bit2, Bit3;
+			Minesweeper::ForEachNeighbor(Width, Height, Index, [&](const int Neighbor) {
+				const FLanes& In = Mines[Neighbor];
+				const FLanes Carry0 = Bit0 & In;
+				Bit0 = Bit0 ^ In;
+				const FLanes Carry1 = Bit1 & Carry0;
+				Bit1 = Bit1 ^ Carry0;
+				const FLanes Carry2 = Bit2 & Carry1;
+				Bit2 = Bit2 ^ Carry1;
+				Bit3 |= Carry2;
+			});
+
+			Counts[0][Index] = Bit0;
+			Counts[1][Index] = Bit1;
+			Counts[2][Index] = Bit2;
+			Counts[3][Index] = Bit3;
+			Zero[Index] = ~(Mines[Index] | Bit0 | Bit1 | Bit2 | Bit3);
+		}
+	}
+
+	void Expand()
+	{
+		// A cell is only on the list while it has lanes left to spread, whatever arrives before it comes off rides along
+		while (Worklist.Num()) {
+			const int Cell = Worklist.Pop(EAllowShrinking::No);
+			const FLanes Spread = Pending[Cell];
+			Pending[Cell] = FLanes();
+
+			// Lanes where this is a zero have no mines around it, so no mine check on the way out
+			Minesweeper::ForEachNeighbor(Width, Height, Cell, [&](const int Neighbor) {
+				const FLanes New = Spread & ~Exposed[Neighbor];
+				if (New.IsEmpty()) {
+					return;
+				}
+
+				Exposed[Neighbor] |= New;
+				CountExposed(New);
+
+				const FLanes Open = New & Zero[Neighbor];
+				if (Open.IsEmpty()) {
+					return;
+				}
+
+				if (Pending[Neighbor].IsEmpty()) {
+					Worklist.Add(Neighbor);
+				}
+
+				Pending[Neighbor] |= Open;
+			});
+		}
+	}
+
+	// Safe tiles that just got exposed, one per set lane. Work goes with what was exposed rather than the board size
+	void CountExposed(const FLanes& Safe)
+	{
+		for (int i = 0; i < InWords; i++) {
+			for (uint64 Bits = Safe.Words[i]; Bits; Bits &= Bits - 1) {
+				const int Board = i * 64 + FMath::CountTrailingZeros64(Bits);
+				if (--HiddenSafe[Board] == 0) {
+					Won.Set(Board);
+				}
+			}
+		}
+	}
+
+	TArray<FLanes> Mines;
+	TArray<FLanes> Zero;
+	TArray<FLanes> Exposed;
+
+	// Lanes that opened up on a cell and havent spread to its neighbors yet
+	TArray<FLanes> Pending;
+	TArray<int> Worklist;
+
+	// Bit sliced neighbor mine count, plane N is bit N
+	TArray<FLanes> Counts[4];
+
+	FLanes Won;
+	FLanes Lost;
+	TStaticArray<int, BoardCount> HiddenSafe { InPlace, 0 };
+};
+
+using FMinesweeperBitSlicedBoards64 = TMinesweeperBitSlicedBoards<1>;
+using FMinesweeperBitSlicedBoards256 = TMinesweeperBitSlicedBoards<4>;
@@ -0,0 +1,243 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GeoTechMinesweeper.h"
+
+#include <array>
+
+// Board shape the rules are written against. The dynamic one works its neighbors out at runtime,
+// the fixed one has them in a constexpr table so the loops unroll and the multiplies fold away
+
+struct FMinesweeperDynamicLayout
+{
+	int Width = 0, Height = 0;
+
+	template<typename FunctorType>
+	FORCEINLINE void ForEachNeighbor(const int Index, FunctorType&& Functor) const
+	{
+		Minesweeper::ForEachNeighbor(Width, Height, Index, Forward<FunctorType>(Functor));
+	}
+};
+
+template<int InWidth, int InHeight>
+struct TMinesweeperFixedLayout
+{
+	static constexpr int Width = InWidth;
+	static constexpr int Height = InHeight;
+	static constexpr int CellCount = InWidth * InHeight;
+
+	// Neighbors that fall off the board point one past the last tile
+	static constexpr int Sentinel = CellCount;
+
+	static_assert(CellCount > 0 && CellCount < MAX_uint16, "Fixed layouts are meant for the preset sizes");
+
+	using FNeighborTable = std::array<std::array<uint16, 8>, CellCount>;
+
+	static constexpr FNeighborTable BuildNeighborTable()
+	{
+		FNeighborTable Table = {};
+		for (int Index = 0; Index < CellCount; Index++) {
+			const int X = Index % Width;
+			const int Y = Index / Width;
+
+			// Same order as the dynamic layout, row by row
+			int Slot = 0;
+			for (int j = Y - 1; j <= Y + 1; j++) {
+				for (int i = X - 1; i <= X + 1; i++) {
+					if (i == X && j == Y) {
+						continue;
+					}
+
+					const bool bInside = i >= 0 && j >= 0 && i < Width && j < Height;
+					Table[Index][Slot++] = static_cast<uint16>(bInside ? i + j * Width : Sentinel);
+				}
+			}
+		}
+
+		return Table;
+	}
+
+	static constexpr FNeighborTable Neighbors = BuildNeighborTable();
+
+	template<typename FunctorType>
+	FORCEINLINE void ForEachNeighbor(const int Index, FunctorType&& Functor) const
+	{
+		const std::array<uint16, 8>& Row = Neighbors[Index];
+		for (int Slot = 0; Slot < 8; Slot++) {
+			if (Row[Slot] != Sentinel) {
+				Functor(static_cast<int>(Row[Slot]));
+			}
+		}
+	}
+};
+
+template<typename LayoutType>
+void FMinesweeperGame::CountNeighborMines(const LayoutType& Layout)
+{
+	// Counts come from the mines outwards, no per tile neighborhood scan
+	for (const int MineIndex : MineIndices) {
+		Layout.ForEachNeighbor(MineIndex, [this](const int Neighbor) {
+			Board[Neighbor].MinesInArea++;
+		});
+	}
+}
+
+template<typename LayoutType>
+void FMinesweeperGame::AnalyzeOpenings(const LayoutType& Layout)
+{
+	const int CellCount = Layout.Width * Layout.Height;
+
+	const auto IsZero = [this](const int Index) {
+		return !Board[Index].IsMine && !Board[Index].MinesInArea;
+	};
+
+	// Single raster pass union-find over the zero tiles. only the neighbors already visited need joining,
+	// and the lower index always wins so every root is the first tile of its opening
+	TArray<int> Parent;
+	Parent.SetNumUninitialized(CellCount);
+
+	const auto FindRoot = [&Parent](int Index) {
+		while (Parent[Index] != Index) {
+			Parent[Index] = Parent[Parent[Index]];
+			Index = Parent[Index];
+		}
+		
+		return Index;
+	};
+
+	const auto Union = [&Parent, &FindRoot](const int A, const int B) {
+		const int RootA = FindRoot(A);
+		const int RootB = FindRoot(B);
+		if (RootA != RootB) {
+			Parent[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+		}
+	};
+
+	for (int j = 0; j < Layout.Height; j++) {
+		for (int i = 0; i < Layout.Width; i++) {
+			const int Index = i + j * Layout.Width;
+			if (!IsZero(Index)) {
+				Parent[Index] = INDEX_NONE;
+				continue;
+			}
+
+			Parent[Index] = Index;
+
+			// West, north west, north, north east
+			if (i > 0 && IsZero(Index - 1)) {
+				Union(Index, Index - 1);
+			}
+
+			if (j > 0) {
+				for (int k = FMath::Max(i - 1, 0); k <= FMath::Min(i + 1, Layout.Width - 1); k++) {
+					if (IsZero(k + (j - 1) * Layout.Width)) {
+						Union(Index, k + (j - 1) * Layout.Width);
+					}
+				}
+			}
+		}
+	}
+
+	// Roots come before the rest of their set, so labels are handed out in one more pass
+	int NumOpenings = 0;
+	int IsolatedCount = 0;
+	OpeningLabels.SetNumUninitialized(CellCount);
+	for (int Index = 0; Index < CellCount; Index++) {
+		if (IsZero(Index)) {
+			const int Root = FindRoot(Index);
+			OpeningLabels[Index] = Root == Index ? NumOpenings++ : OpeningLabels[Root];
+			continue;
+		}
+
+		OpeningLabels[Index] = INDEX_NONE;
+		if (Board[Index].IsMine) {
+			continue;
+		}
+
+		// Numbers with no zero next to them each need their own click
+		bool bTouchesOpening = false;
+		Layout.ForEachNeighbor(Index, [&](const int Neighbor) {
+			bTouchesOpening |= IsZero(Neighbor);
+		});
+
+		if (!bTouchesOpening) {
+			OpeningLabels[Index] = IsolatedTile;
+			IsolatedCount++;
+		}
+	}
+
+	ThreeBV = NumOpenings + IsolatedCount;
+
+	// Flatten every opening plus its numbered border into one list, a border tile can belong to a few openings
+	const auto GatherOpenings = [&](const int Index, TArray<int, TInlineAllocator<8>>& OutLabels) {
+		OutLabels.Reset();
+		if (OpeningLabels[Index] >= 0) {
+			OutLabels.Add(OpeningLabels[Index]);
+			return;
+		}
+
+		if (Board[Index].IsMine || OpeningLabels[Index] == IsolatedTile) {
+			return;
+		}
+
+		Layout.ForEachNeighbor(Index, [&](const int Neighbor) {
+			if (OpeningLabels[Neighbor] >= 0) {
+				OutLabels.AddUnique(OpeningLabels[Neighbor]);
+			}
+		});
+	};
+
+	TArray<int, TInlineAllocator<8>> Labels;
+	OpeningOffsets.SetNumZeroed(NumOpenings + 1);
+	for (int Index = 0; Index < CellCount; Index++) {
+		GatherOpenings(Index, Labels);
+		for (const int Label : Labels) {
+			OpeningOffsets[Label + 1]++;
+		}
+	}
+
+	for (int Label = 0; Label < NumOpenings; Label++) {
+		OpeningOffsets[Label + 1] += OpeningOffsets[Label];
+	}
+
+	TArray<int> Cursor(OpeningOffsets.GetData(), NumOpenings);
+	OpeningTiles.SetNumUninitialized(OpeningOffsets[NumOpenings]);
+	for (int Index = 0; Index < CellCount; Index++) {
+		GatherOpenings(Index, Labels);
+		for (const int Label : Labels) {
+			OpeningTiles[Cursor[Label]++] = Index;
+		}
+	}
+
+	OpeningsRevealed.Init(false, NumOpenings);
+}
+
+template<typename LayoutType>
+bool FMinesweeperGame::ChordWithLayout(const LayoutType& Layout, const int Index)
+{
+	const FMinesweeperTile& Tile = Board[Index];
+	if (IsGameComplete() || !Tile.IsExposed || Tile.IsMine || !Tile.MinesInArea) {
+		return false;
+	}
+
+	// Only once the flags around it add up, a wrong flag loses the game here just like it should
+	int Flags = 0;
+	Layout.ForEachNeighbor(Index, [this, &Flags](const int Neighbor) {
+		Flags += Board[Neighbor].IsFlagged;
+	});
+
+	if (Flags != Tile.MinesInArea) {
+		return false;
+	}
+
+	bool bChanged = false;
+	Layout.ForEachNeighbor(Index, [this, &bChanged](const int Neighbor) {
+		if (!Board[Neighbor].IsFlagged && !IsGameComplete()) {
+			bChanged |= Reveal(Neighbor);
+		}
+	});
+
+	return bChanged;
+}
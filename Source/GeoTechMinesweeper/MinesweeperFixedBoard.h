@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperBoardLayout.h"
+
+#include <array>
+#include <bitset>
+
+// Game with its size known at compile time. Tiles and mines live inline in the object, no separate board allocation,
+// and every neighbor walk goes through the constexpr table of TMinesweeperFixedLayout
+template<int InWidth, int InHeight, int InMineCount>
+class TFixedMinesweeperBoard: public FMinesweeperGame
+{
+public:
+	using FLayout = TMinesweeperFixedLayout<InWidth, InHeight>;
+	static constexpr int CellCount = FLayout::CellCount;
+
+	static_assert(InMineCount >= 1 && InMineCount <= CellCount, "Mine count has to fit on the board");
+
+	explicit TFixedMinesweeperBoard(const int Seed)
+		: FMinesweeperGame(InWidth, InHeight, InMineCount, nullptr)
+	{
+		Board = Tiles.data();
+		Initialize(Seed);
+	}
+
+	virtual ~TFixedMinesweeperBoard() override
+	{
+		StopSimulation();
+	}
+
+	static constexpr bool Matches(const int Width, const int Height, const int MineCount)
+	{
+		return Width == InWidth && Height == InHeight && MineCount == InMineCount;
+	}
+
+	virtual bool Chord(const int Index) override
+	{
+		return ChordWithLayout(FLayout(), Index);
+	}
+
+protected:
+	virtual void PlaceMines() override
+	{
+		FMinesweeperGame::PlaceMines();
+		for (const int Index : MineIndices) {
+			MineBits.set(Index);
+		}
+	}
+
+	virtual void AnalyzeBoard() override
+	{
+		// Gather instead of scatter, the sentinel bit is never set so edge tiles dont need a special case
+		for (int Index = 0; Index < CellCount; Index++) {
+			const std::array<uint16, 8>& Row = FLayout::Neighbors[Index];
+
+			int Count = 0;
+			for (int Slot = 0; Slot < 8; Slot++) {
+				Count += MineBits[Row[Slot]];
+			}
+
+			Tiles[Index].MinesInArea = Count;
+		}
+
+		AnalyzeOpenings(FLayout());
+	}
+
+	std::array<FMinesweeperTile, CellCount> Tiles;
+
+	// One past the end for the sentinel neighbor
+	std::bitset<CellCount + 1> MineBits;
+};
+
+// 8x8 for beginner, 10 mines
+// 16x16 for intermediate 40 mines
+// 32x16 for expert 99 mines
+// 32x32 for impossible 170 mines
+using FEasyMinesweeperBoard = TFixedMinesweeperBoard<8, 8, 10>;
+using FMediumMinesweeperBoard = TFixedMinesweeperBoard<16, 16, 40>;
+using FHardMinesweeperBoard = TFixedMinesweeperBoard<32, 16, 99>;
+using FImpossibleMinesweeperBoard = TFixedMinesweeperBoard<32, 32, 170>;
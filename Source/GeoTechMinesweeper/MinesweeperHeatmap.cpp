@@ -0,0 +1,385 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperHeatmap.h"
+
+namespace MinesweeperHeatmap
+{
+	// Enumeration is exponential in component size, anything past these gets a local estimate instead
+	constexpr int MaxComponentTiles = 28;
+	constexpr int64 MaxSearchNodes = 1 << 20;
+
+	// How often the search looks up from its work to see if its still wanted
+	constexpr int64 CancelCheckInterval = 1024;
+
+	// Hidden tiles sharing numbers, solved together and independently of every other component
+	struct FComponent
+	{
+		TArray<int> Tiles;
+		TArray<int> Constraints;
+	};
+
+	// Walks every mine assignment of a component that satisfies its numbers.
+	// Solutions[K] counts assignments with K mines, Hits[Tile * (TileCount + 1) + K] those that have Tile as a mine
+	struct FEnumerator
+	{
+		struct FConstraint
+		{
+			int Target = 0;
+			int Mines = 0;
+			int Unassigned = 0;
+			TArray<int, TInlineAllocator<8>> Tiles;
+		};
+
+		TArray<FConstraint> Constraints;
+		TArray<TArray<int, TInlineAllocator<8>>> TileConstraints;
+		TArray<uint8> Assignment;
+		TArray<double> Solutions;
+		TArray<double> Hits;
+
+		TFunctionRef<bool()> IsCancelled;
+		int64 Nodes = 0;
+		bool bAborted = false;
+
+		explicit FEnumerator(TFunctionRef<bool()> InIsCancelled)
+			: IsCancelled(InIsCancelled)
+		{
+		}
+
+		bool Assign(const int Tile, const uint8 Value)
+		{
+			bool bValid = true;
+			for (const int Index : TileConstraints[Tile]) {
+				FConstraint& Constraint = Constraints[Index];
+				Constraint.Unassigned--;
+				Constraint.Mines += Value;
+				bValid &= Constraint.Mines <= Constraint.Target && Constraint.Mines + Constraint.Unassigned >= Constraint.Target;
+			}
+
+			Assignment[Tile] = Value;
+			return bValid;
+		}
+
+		void Unassign(const int Tile)
+		{
+			for (const int Index : TileConstraints[Tile]) {
+				Constraints[Index].Unassigned++;
+				Constraints[Index].Mines -= Assignment[Tile];
+			}
+		}
+
+		void Search(const int Tile, const int Mines)
+		{
+			if (bAborted) {
+				return;
+			}
+
+			if (++Nodes % CancelCheckInterval == 0 && (Nodes > MaxSearchNodes || IsCancelled())) {
+				bAborted = true;
+				return;
+			}
+
+			const int TileCount = Assignment.Num();
+			if (Tile == TileCount) {
+				Solutions[Mines] += 1.0;
+				for (int i = 0; i < TileCount; i++) {
+					Hits[i * (TileCount + 1) + Mines] += Assignment[i];
+				}
+
+				return;
+			}
+
+			for (uint8 Value = 0; Value <= 1; Value++) {
+				if (Assign(Tile, Value)) {
+					Search(Tile + 1, Mines + Value);
+				}
+
+				Unassign(Tile);
+			}
+		}
+	};
+}
+
+FMinesweeperHeatmapSolver::~FMinesweeperHeatmapSolver()
+{
+	delete Pending.exchange(nullptr);
+}
+
+void FMinesweeperHeatmapSolver::Request(FMinesweeperView&& View)
+{
+	const uint64 Generation = ++LatestGeneration;
+	TSharedRef<FMinesweeperHeatmapSolver, ESPMode::ThreadSafe> Self = AsShared();
+
+	auto Body = [Self, Generation, View = MoveTemp(View)] {
+		const auto IsCancelled = [&Self, Generation] {
+			return Self->LatestGeneration.load(std::memory_order_relaxed) != Generation;
+		};
+
+		if (IsCancelled()) {
+			return;
+		}
+
+		TUniquePtr<FMinesweeperHeatmap> Heatmap = MakeUnique<FMinesweeperHeatmap>();
+		Heatmap->Generation = Generation;
+		// A request can come in while the last components are being solved, that result is already stale
+		if (Compute(View, *Heatmap, IsCancelled) && !IsCancelled()) {
+			Self->Publish(Heatmap.Release());
+		}
+	};
+
+	// Chained behind the previous request so results only ever land in order, that one is already bailing out
+	if (LastTask.IsValid()) {
+		LastTask = UE::Tasks::Launch(TEXT("MinesweeperHeatmap"), MoveTemp(Body), UE::Tasks::Prerequisites(LastTask), UE::Tasks::ETaskPriority::BackgroundNormal);
+		return;
+	}
+
+	LastTask = UE::Tasks::Launch(TEXT("MinesweeperHeatmap"), MoveTemp(Body), UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FMinesweeperHeatmapSolver::Cancel()
+{
+	++LatestGeneration;
+}
+
+const FMinesweeperHeatmap* FMinesweeperHeatmapSolver::Get()
+{
+	// Cheap look first, this runs for every hidden tile every frame
+	if (Pending.load(std::memory_order_relaxed)) {
+		if (FMinesweeperHeatmap* Heatmap = Pending.exchange(nullptr, std::memory_order_acquire)) {
+			// Superseded between its last check and the swap, the board has moved on since
+			if (Heatmap->Generation != LatestGeneration.load(std::memory_order_relaxed)) {
+				delete Heatmap;
+				return Current.Get();
+			}
+
+			Current.Reset(Heatmap);
+		}
+	}
+
+	return Current.Get();
+}
+
+void FMinesweeperHeatmapSolver::Publish(FMinesweeperHeatmap* Heatmap)
+{
+	// Whatever was still pending was never picked up by the game thread, so its ours to throw away
+	delete Pending.exchange(Heatmap, std::memory_order_acq_rel);
+}
+
+bool FMinesweeperHeatmapSolver::Compute(const FMinesweeperView& View, FMinesweeperHeatmap& Out, TFunctionRef<bool()> IsCancelled)
+{
+	using namespace MinesweeperHeatmap;
+
+	const int CellCount = View.Cells.Num();
+	Out.Probabilities.Init(-1.0f, CellCount);
+
+	// Flags are only what the player thinks, they are treated like any other hidden tile
+	const auto IsUnknown = [&View](const int Index) {
+		return View.IsHidden(Index) || View.IsFlagged(Index);
+	};
+
+	// Frontier tiles get a compact id, joined into components through the numbers they share
+	TMap<int, int> FrontierIds;
+	TArray<int> FrontierTiles;
+	TArray<int> Parent;
+	TArray<int> Numbers;
+
+	const auto FindRoot = [&Parent](int Id) {
+		while (Parent[Id] != Id) {
+			Parent[Id] = Parent[Parent[Id]];
+			Id = Parent[Id];
+		}
+
+		return Id;
+	};
+
+	int UnknownCount = 0;
+	for (int Index = 0; Index < CellCount; Index++) {
+		if ((Index & 4095) == 0 && IsCancelled()) {
+			return false;
+		}
+
+		if (IsUnknown(Index)) {
+			UnknownCount++;
+			continue;
+		}
+
+		if (!View.IsExposed(Index) || !View.Cells[Index]) {
+			continue;
+		}
+
+		int First = INDEX_NONE;
+		View.ForEachNeighbor(Index, [&](const int Neighbor) {
+			if (!IsUnknown(Neighbor)) {
+				return;
+			}
+
+			int* Id = FrontierIds.Find(Neighbor);
+			if (!Id) {
+				Id = &FrontierIds.Add(Neighbor, FrontierTiles.Add(Neighbor));
+				Parent.Add(*Id);
+			}
+
+			if (First == INDEX_NONE) {
+				First = *Id;
+				return;
+			}
+
+			const int RootA = FindRoot(First);
+			const int RootB = FindRoot(*Id);
+			Parent[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+		});
+
+		if (First != INDEX_NONE) {
+			Numbers.Add(Index);
+		}
+	}
+
+	TMap<int, int> ComponentOfRoot;
+	TArray<FComponent> Components;
+	for (int Id = 0; Id < FrontierTiles.Num(); Id++) {
+		const int Root = FindRoot(Id);
+		int* Component = ComponentOfRoot.Find(Root);
+		if (!Component) {
+			Component = &ComponentOfRoot.Add(Root, Components.AddDefaulted());
+		}
+
+		Components[*Component].Tiles.Add(FrontierTiles[Id]);
+	}
+
+	for (const int Number : Numbers) {
+		int Root = INDEX_NONE;
+		View.ForEachNeighbor(Number, [&](const int Neighbor) {
+			if (Root == INDEX_NONE && IsUnknown(Neighbor)) {
+				Root = FindRoot(FrontierIds[Neighbor]);
+			}
+		});
+
+		Components[ComponentOfRoot[Root]].Constraints.Add(Number);
+	}
+
+	// Each solved component keeps its per mine count tallies, weighted against the interior density afterwards
+	struct FSolved
+	{
+		int Component = 0;
+		TArray<double> Solutions;
+		TArray<double> Hits;
+	};
+
+	TArray<FSolved> Solved;
+	double EstimatedMines = 0.0;
+
+	for (int ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++) {
+		const FComponent& Component = Components[ComponentIndex];
+		const int TileCount = Component.Tiles.Num();
+
+		TMap<int, int> LocalIds;
+		for (int i = 0; i < TileCount; i++) {
+			LocalIds.Add(Component.Tiles[i], i);
+		}
+
+		FEnumerator Enumerator(IsCancelled);
+		Enumerator.TileConstraints.SetNum(TileCount);
+		Enumerator.Assignment.SetNumZeroed(TileCount);
+		Enumerator.Solutions.SetNumZeroed(TileCount + 1);
+		Enumerator.Hits.SetNumZeroed(TileCount * (TileCount + 1));
+
+		for (const int Number : Component.Constraints) {
+			FEnumerator::FConstraint& Constraint = Enumerator.Constraints.AddDefaulted_GetRef();
+			Constraint.Target = View.Cells[Number];
+			View.ForEachNeighbor(Number, [&](const int Neighbor) {
+				if (const int* Local = LocalIds.Find(Neighbor)) {
+					Constraint.Tiles.Add(*Local);
+					Enumerator.TileConstraints[*Local].Add(Enumerator.Constraints.Num() - 1);
+				}
+			});
+
+			Constraint.Unassigned = Constraint.Tiles.Num();
+		}
+
+		if (TileCount <= MaxComponentTiles) {
+			Enumerator.Search(0, 0);
+		}
+
+		if (IsCancelled()) {
+			return false;
+		}
+
+		const bool bSolved = TileCount <= MaxComponentTiles && !Enumerator.bAborted;
+		if (bSolved) {
+			Solved.Add({ ComponentIndex, MoveTemp(Enumerator.Solutions), MoveTemp(Enumerator.Hits) });
+			continue;
+		}
+
+		// Too big to enumerate, each tile takes the worst odds of the numbers around it
+		for (int i = 0; i < TileCount; i++) {
+			float Probability = 0.0f;
+			for (const int Index : Enumerator.TileConstraints[i]) {
+				const FEnumerator::FConstraint& Constraint = Enumerator.Constraints[Index];
+				Probability = FMath::Max(Probability, static_cast<float>(Constraint.Target) / Constraint.Tiles.Num());
+			}
+
+			Out.Probabilities[Component.Tiles[i]] = Probability;
+			EstimatedMines += Probability;
+		}
+	}
+
+	// Components only interact through the mine total. Weighting K mine solutions by (d / (1 - d))^K
+	// with d the density left for the interior is the usual independent approximation, settled in a few passes
+	const int InteriorCount = UnknownCount - FrontierTiles.Num();
+	double Density = UnknownCount ? static_cast<double>(View.MineCount) / UnknownCount : 0.0;
+
+	TArray<double> Weights;
+	for (int Pass = 0; Pass < 4; Pass++) {
+		const double Clamped = FMath::Clamp(Density, 1e-6, 1.0 - 1e-6);
+		const double Ratio = InteriorCount ? Clamped / (1.0 - Clamped) : 1.0;
+
+		double FrontierMines = EstimatedMines;
+		for (const FSolved& Component : Solved) {
+			double Total = 0.0, Expected = 0.0, Weight = 1.0;
+			for (int K = 0; K < Component.Solutions.Num(); K++, Weight *= Ratio) {
+				Total += Component.Solutions[K] * Weight;
+				Expected += Component.Solutions[K] * Weight * K;
+			}
+
+			FrontierMines += Total > 0.0 ? Expected / Total : 0.0;
+		}
+
+		if (!InteriorCount) {
+			break;
+		}
+
+		Density = FMath::Clamp((View.MineCount - FrontierMines) / InteriorCount, 0.0, 1.0);
+	}
+
+	const double Clamped = FMath::Clamp(Density, 1e-6, 1.0 - 1e-6);
+	const double Ratio = InteriorCount ? Clamped / (1.0 - Clamped) : 1.0;
+
+	for (const FSolved& Component : Solved) {
+		const TArray<int>& Tiles = Components[Component.Component].Tiles;
+		const int Width = Component.Solutions.Num();
+
+		Weights.SetNumUninitialized(Width);
+		double Total = 0.0, Weight = 1.0;
+		for (int K = 0; K < Width; K++, Weight *= Ratio) {
+			Weights[K] = Weight;
+			Total += Component.Solutions[K] * Weight;
+		}
+
+		for (int i = 0; i < Tiles.Num(); i++) {
+			double Mine = 0.0;
+			for (int K = 0; K < Width; K++) {
+				Mine += Component.Hits[i * Width + K] * Weights[K];
+			}
+
+			// No solution at all means the flags or numbers contradict each other, leave it unknown
+			Out.Probabilities[Tiles[i]] = Total > 0.0 ? static_cast<float>(Mine / Total) : -1.0f;
+		}
+	}
+
+	for (int Index = 0; Index < CellCount; Index++) {
+		if (IsUnknown(Index) && !FrontierIds.Contains(Index)) {
+			Out.Probabilities[Index] = static_cast<float>(Density);
+		}
+	}
+
+	return true;
+}
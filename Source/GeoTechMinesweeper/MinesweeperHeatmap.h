@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GeoTechMinesweeper.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+// Mine probability of every tile for one board state. Never modified once published
+struct FMinesweeperHeatmap
+{
+	// Request it was computed for, anything older than the latest one never gets shown
+	uint64 Generation = 0;
+
+	// Negative for tiles that arent hidden
+	TArray<float> Probabilities;
+};
+
+// Works out heatmaps on the task graph. Every request supersedes the one before it, a stale computation notices
+// the newer generation and bails out. Results are handed over through a single atomic pointer swap,
+// the game thread never takes a lock to read them
+class FMinesweeperHeatmapSolver: public TSharedFromThis<FMinesweeperHeatmapSolver, ESPMode::ThreadSafe>
+{
+public:
+	virtual ~FMinesweeperHeatmapSolver();
+
+	// Game thread. View is a snapshot the worker owns from here on
+	void Request(FMinesweeperView&& View);
+	void Cancel();
+
+	// Game thread. Newest published heatmap, or nullptr before the first one lands
+	const FMinesweeperHeatmap* Get();
+
+	// Fills Out for View, false if IsCancelled fired part way through
+	static bool Compute(const FMinesweeperView& View, FMinesweeperHeatmap& Out, TFunctionRef<bool()> IsCancelled);
+
+protected:
+	void Publish(FMinesweeperHeatmap* Heatmap);
+
+	std::atomic<uint64> LatestGeneration { 0 };
+	std::atomic<FMinesweeperHeatmap*> Pending { nullptr };
+
+	// Game thread only
+	TUniquePtr<FMinesweeperHeatmap> Current;
+	UE::Tasks::FTask LastTask;
+};
@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperLodPyramid.h"
+#include "GeoTechMinesweeper.h"
+
+void FMinesweeperLodPyramid::Initialize(const FMinesweeperGame& Game)
+{
+	Reset();
+
+	Width = Game.Width;
+	Height = Game.Height;
+
+	const int CellCount = Width * Height;
+	CellBits.SetNumZeroed(CellCount);
+	DirtyMask.Init(false, CellCount);
+
+	// Enough levels that the last one is a single texel
+	const int LevelCount = 1 + FMath::CeilLogTwo(FMath::Max(Width, Height));
+	Levels.SetNum(LevelCount);
+	for (int Level = 1; Level < LevelCount; Level++) {
+		FLevel& Data = Levels[Level];
+		Data.Width = FMath::DivideAndRoundUp(Width, 1 << Level);
+		Data.Height = FMath::DivideAndRoundUp(Height, 1 << Level);
+		Data.Texels.SetNum(Data.Width * Data.Height);
+	}
+
+	// One full pass at creation, everything after this is incremental
+	for (int Index = 0; Index < CellCount; Index++) {
+		const uint8 Bits = GetCellBits(Game, Index);
+		CellBits[Index] = Bits;
+		if (!Bits) {
+			continue;
+		}
+
+		const int X = Index % Width;
+		const int Y = Index / Width;
+		for (int Level = 1; Level < LevelCount; Level++) {
+			FLevel& Data = Levels[Level];
+			FMinesweeperLodTexel& Texel = Data.Texels[(X >> Level) + (Y >> Level) * Data.Width];
+			Texel.Exposed += (Bits & CellExposed) != 0;
+			Texel.Flagged += (Bits & CellFlagged) != 0;
+			Texel.Mines += (Bits & CellMine) != 0;
+		}
+	}
+}
+
+void FMinesweeperLodPyramid::Reset()
+{
+	Width = Height = 0;
+	Levels.Empty();
+	CellBits.Empty();
+	DirtyCells.Empty();
+	DirtyMask.Empty();
+}
+
+bool FMinesweeperLodPyramid::IsInitialized() const
+{
+	return Levels.Num() > 0;
+}
+
+void FMinesweeperLodPyramid::MarkDirty(const int Index)
+{
+	if (!IsInitialized() || DirtyMask[Index]) {
+		return;
+	}
+
+	DirtyMask[Index] = true;
+	DirtyCells.Add(Index);
+}
+
+void FMinesweeperLodPyramid::Flush(const FMinesweeperGame& Game)
+{
+	for (const int Index : DirtyCells) {
+		DirtyMask[Index] = false;
+
+		const uint8 OldBits = CellBits[Index];
+		const uint8 NewBits = GetCellBits(Game, Index);
+		if (OldBits == NewBits) {
+			continue;
+		}
+
+		CellBits[Index] = NewBits;
+
+		// Mines never move, only exposed and flagged can change after creation
+		const int ExposedDelta = ((NewBits & CellExposed) != 0) - ((OldBits & CellExposed) != 0);
+		const int FlaggedDelta = ((NewBits & CellFlagged) != 0) - ((OldBits & CellFlagged) != 0);
+
+		const int X = Index % Width;
+		const int Y = Index / Width;
+		for (int Level = 1; Level < Levels.Num(); Level++) {
+			FLevel& Data = Levels[Level];
+			FMinesweeperLodTexel& Texel = Data.Texels[(X >> Level) + (Y >> Level) * Data.Width];
+			Texel.Exposed += ExposedDelta;
+			Texel.Flagged += FlaggedDelta;
+		}
+	}
+
+	DirtyCells.Reset();
+}
+
+int FMinesweeperLodPyramid::GetLevelCount() const
+{
+	return Levels.Num();
+}
+
+FIntPoint FMinesweeperLodPyramid::GetLevelSize(const int Level) const
+{
+	if (Level == 0) {
+		return { Width, Height };
+	}
+
+	return { Levels[Level].Width, Levels[Level].Height };
+}
+
+FMinesweeperLodTexel FMinesweeperLodPyramid::GetTexel(const int Level, const int X, const int Y) const
+{
+	if (Level == 0) {
+		const uint8 Bits = CellBits[X + Y * Width];
+
+		FMinesweeperLodTexel Texel;
+		Texel.Exposed = (Bits & CellExposed) != 0;
+		Texel.Flagged = (Bits & CellFlagged) != 0;
+		Texel.Mines = (Bits & CellMine) != 0;
+		return Texel;
+	}
+
+	const FLevel& Data = Levels[Level];
+	return Data.Texels[X + Y * Data.Width];
+}
+
+int FMinesweeperLodPyramid::GetTexelCellCount(const int Level, const int X, const int Y) const
+{
+	// Edge texels hang off the board when the size isnt a power of two
+	const int Size = 1 << Level;
+	const int CoveredWidth = FMath::Min(Size, Width - X * Size);
+	const int CoveredHeight = FMath::Min(Size, Height - Y * Size);
+	return CoveredWidth * CoveredHeight;
+}
+
+int FMinesweeperLodPyramid::SelectLevel(const float PixelsPerCell, const float MinTexelPx) const
+{
+	if (PixelsPerCell >= MinTexelPx) {
+		return 0;
+	}
+
+	const int Level = FMath::CeilToInt(FMath::Log2(MinTexelPx / PixelsPerCell));
+	return FMath::Clamp(Level, 0, Levels.Num() - 1);
+}
+
+FLinearColor FMinesweeperLodPyramid::GetTexelColor(const FMinesweeperLodTexel& Texel, const int CellCount, const bool bRevealMines)
+{
+	const float Count = FMath::Max(CellCount, 1);
+
+	// Same palette as the tiles, hidden grey fading into exposed slate as the area opens up
+	FLinearColor Color = FMath::Lerp(FLinearColor(FColorList::DimGrey), FLinearColor(FColorList::DarkSlateGrey), Texel.Exposed / Count);
+	Color = FMath::Lerp(Color, FLinearColor(FColorList::Red), FMath::Min(1.0f, Texel.Flagged * 4.0f / Count));
+
+	if (bRevealMines && Texel.Mines) {
+		Color = FMath::Lerp(Color, FLinearColor(FColor::Red), FMath::Min(1.0f, Texel.Mines * 4.0f / Count));
+	}
+
+	return Color;
+}
+
+SIZE_T FMinesweeperLodPyramid::GetAllocatedSize() const
+{
+	SIZE_T Size = Levels.GetAllocatedSize() + CellBits.GetAllocatedSize() + DirtyCells.GetAllocatedSize() + DirtyMask.GetAllocatedSize();
+	for (const FLevel& Level : Levels) {
+		Size += Level.Texels.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+uint8 FMinesweeperLodPyramid::GetCellBits(const FMinesweeperGame& Game, const int Index)
+{
+	// Exposed and flagged come from the snapshot the game thread draws, mines never move once generated
+	const EMinesweeperCell Cell = static_cast<EMinesweeperCell>(Game.GetDisplayCell(Index));
+	const bool bExposed = Cell != EMinesweeperCell::Hidden && Cell != EMinesweeperCell::Flagged;
+
+	uint8 Bits = 0;
+	Bits |= bExposed ? CellExposed : 0;
+	Bits |= Cell == EMinesweeperCell::Flagged ? CellFlagged : 0;
+	Bits |= Game.GetTile(Index % Game.Width, Index / Game.Width).IsMine ? CellMine : 0;
+	return Bits;
+}
@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FMinesweeperGame;
+
+// Aggregated state of every cell covered by one texel
+struct FMinesweeperLodTexel
+{
+	uint32 Exposed = 0;
+	uint32 Flagged = 0;
+	uint32 Mines = 0;
+};
+
+// Mip pyramid of board state, level N texels cover 2^N x 2^N cells.
+// Tiles mark themselves dirty when they change and Flush() pushes the difference up every level,
+// so keeping the pyramid current costs O(levels) per changed cell instead of a rebuild
+class FMinesweeperLodPyramid
+{
+public:
+	void Initialize(const FMinesweeperGame& Game);
+	void Reset();
+	bool IsInitialized() const;
+
+	void MarkDirty(const int Index);
+	void Flush(const FMinesweeperGame& Game);
+
+	int GetLevelCount() const;
+	FIntPoint GetLevelSize(const int Level) const;
+	FMinesweeperLodTexel GetTexel(const int Level, const int X, const int Y) const;
+	int GetTexelCellCount(const int Level, const int X, const int Y) const;
+
+	// Finest level where one texel is at least MinTexelPx wide at the given scale
+	int SelectLevel(const float PixelsPerCell, const float MinTexelPx) const;
+
+	static FLinearColor GetTexelColor(const FMinesweeperLodTexel& Texel, const int CellCount, const bool bRevealMines);
+
+	SIZE_T GetAllocatedSize() const;
+
+protected:
+	enum ECellBits : uint8
+	{
+		CellExposed = 1 << 0,
+		CellFlagged = 1 << 1,
+		CellMine = 1 << 2
+	};
+
+	static uint8 GetCellBits(const FMinesweeperGame& Game, const int Index);
+
+	struct FLevel
+	{
+		int Width = 0, Height = 0;
+		TArray<FMinesweeperLodTexel> Texels;
+	};
+
+	int Width = 0, Height = 0;
+
+	// Level 0 is read straight from the cell bits, Levels[0] is always empty
+	TArray<FLevel> Levels;
+	TArray<uint8> CellBits;
+
+	TArray<int> DirtyCells;
+	TBitArray<> DirtyMask;
+};
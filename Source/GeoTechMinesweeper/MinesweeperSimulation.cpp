@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperSimulation.h"
+#include "HAL/Event.h"
+#include "HAL/RunnableThread.h"
+
+FMinesweeperSimulation::FMinesweeperSimulation(FMinesweeperGame& InGame)
+	: Game(InGame)
+{
+	// Both buffers start out complete, after that only changed tiles get written
+	for (FMinesweeperSnapshot& Snapshot : Buffers) {
+		Game.GetView(Snapshot.View);
+		Snapshot.SolvedThreeBV = Game.GetSolvedThreeBV();
+	}
+
+	Game.SetRecordChanges(true);
+
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("MinesweeperSimulation"), 0, TPri_AboveNormal);
+}
+
+FMinesweeperSimulation::~FMinesweeperSimulation()
+{
+	if (Thread) {
+		// Stops and waits, whatever was still queued is dropped
+		Thread->Kill(true);
+		delete Thread;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	Game.SetRecordChanges(false);
+}
+
+void FMinesweeperSimulation::Enqueue(const FMinesweeperAction& Action)
+{
+	Commands.Enqueue(Action);
+	WakeEvent->Trigger();
+}
+
+bool FMinesweeperSimulation::AcquireSnapshot()
+{
+	if (!bBackReady.load(std::memory_order_acquire)) {
+		return false;
+	}
+
+	FrontIndex.store(1 - FrontIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	bBackReady.store(false, std::memory_order_release);
+
+	// The simulation might be sitting on changes it couldnt hand over yet
+	WakeEvent->Trigger();
+	return true;
+}
+
+const FMinesweeperSnapshot& FMinesweeperSimulation::GetSnapshot() const
+{
+	return Buffers[FrontIndex.load(std::memory_order_relaxed)];
+}
+
+uint32 FMinesweeperSimulation::Run()
+{
+	while (!bStopping.load(std::memory_order_relaxed)) {
+		WakeEvent->Wait();
+
+		FMinesweeperAction Action;
+		while (!bStopping.load(std::memory_order_relaxed) && Commands.Dequeue(Action)) {
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Game.ApplyAction(Action);
+			PendingLogicCycles += FPlatformTime::Cycles64() - StartCycles;
+
+			ProcessedCommands++;
+			bPendingPublish = true;
+		}
+
+		Publish();
+	}
+
+	return 0;
+}
+
+void FMinesweeperSimulation::Stop()
+{
+	bStopping.store(true, std::memory_order_relaxed);
+	WakeEvent->Trigger();
+}
+
+void FMinesweeperSimulation::Publish()
+{
+	Game.ConsumeChanges(PendingChanges);
+
+	// The game thread still has the last one unread, it wakes us again once it swaps
+	if (!bPendingPublish || bBackReady.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	FMinesweeperSnapshot& Back = Buffers[1 - FrontIndex.load(std::memory_order_relaxed)];
+
+	// Back is one snapshot behind the front, catch it up before adding the new changes
+	WriteCells(Back, PreviousChanges);
+	WriteCells(Back, PendingChanges);
+
+	Back.View.FlagsPlaced = Game.FlagsPlaced;
+	Back.View.State = Game.GetState();
+	Back.SolvedThreeBV = Game.GetSolvedThreeBV();
+	Back.ElapsedSeconds = Game.GetElapsedSeconds();
+	Back.ProcessedCommands = ProcessedCommands;
+	Back.LogicCycles = PendingLogicCycles;
+
+	// Swapped rather than copied and refilled in place, all three arrays keep their allocations around
+	Swap(Back.ChangedCells, PendingChanges);
+	PreviousChanges.Reset();
+	PreviousChanges.Append(Back.ChangedCells);
+	PendingChanges.Reset();
+
+	PendingLogicCycles = 0;
+	bPendingPublish = false;
+	bBackReady.store(true, std::memory_order_release);
+}
+
+void FMinesweeperSimulation::WriteCells(FMinesweeperSnapshot& Snapshot, const TArray<int>& Cells) const
+{
+	for (const int Index : Cells) {
+		Snapshot.View.Cells[Index] = Game.GetViewCell(Index);
+	}
+}
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GeoTechMinesweeper.h"
+#include "Containers/SpscQueue.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+
+// Board state as of some point on the simulation thread, what the game thread draws from
+struct FMinesweeperSnapshot
+{
+	FMinesweeperView View;
+	int SolvedThreeBV = 0;
+	double ElapsedSeconds = 0.0;
+
+	// Player actions applied up to this snapshot, and how long the batch since the previous one took
+	uint64 ProcessedCommands = 0;
+	uint64 LogicCycles = 0;
+
+	// Tiles that changed since the previous snapshot
+	TArray<int> ChangedCells;
+};
+
+// Runs the rules of one game on its own thread. The game thread pushes actions into a single producer single consumer
+// queue, the simulation applies them strictly in order and hands back snapshots through a double buffer.
+// The command queue and the snapshot handoff are lock free, the game thread never waits on the simulation. The simulation
+// thread sleeps on an event while it has nothing to do. While the game thread still hasnt picked up the last snapshot the
+// simulation keeps going and folds everything into the next one
+class FMinesweeperSimulation: public FRunnable
+{
+public:
+	// Game has to outlive the simulation, and from here on only the simulation thread touches its rules state
+	explicit FMinesweeperSimulation(FMinesweeperGame& InGame);
+	virtual ~FMinesweeperSimulation() override;
+
+	// Game thread
+	void Enqueue(const FMinesweeperAction& Action);
+
+	// Game thread. Swaps in the newest snapshot if there is one, false otherwise. The result stays valid until the next swap
+	bool AcquireSnapshot();
+	const FMinesweeperSnapshot& GetSnapshot() const;
+
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+protected:
+	void Publish();
+	void WriteCells(FMinesweeperSnapshot& Snapshot, const TArray<int>& Cells) const;
+
+	FMinesweeperGame& Game;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopping { false };
+
+	TSpscQueue<FMinesweeperAction> Commands;
+
+	// Front belongs to the game thread, the other one to the simulation while bBackReady is false
+	FMinesweeperSnapshot Buffers[2];
+	std::atomic<int> FrontIndex { 0 };
+	std::atomic<bool> bBackReady { false };
+
+	// Simulation thread only
+	uint64 ProcessedCommands = 0;
+	uint64 PendingLogicCycles = 0;
+	bool bPendingPublish = false;
+	TArray<int> PendingChanges;
+
+	// What went into the front buffer, the back one is still missing it
+	TArray<int> PreviousChanges;
+};
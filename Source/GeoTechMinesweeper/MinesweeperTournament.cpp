@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MinesweeperTournament.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+namespace MinesweeperTournament
+{
+	// Log2 buckets of decision time in nanoseconds, the last one catches anything slower than a second
+	constexpr int LatencyBucketCount = 32;
+
+	struct FWorkerContext
+	{
+		TUniquePtr<IMinesweeperAgent> Agent;
+		FMinesweeperView View;
+		TArray<int> ChangedCells;
+
+		int Games = 0;
+		int Wins = 0;
+		int64 Moves = 0;
+		uint64 DecisionCycles = 0;
+		uint64 LatencyBuckets[LatencyBucketCount] = {};
+	};
+
+	double GetBucketMicroseconds(const int Bucket)
+	{
+		return static_cast<double>(uint64(1) << (Bucket + 1)) / 1000.0;
+	}
+
+	double GetPercentileMicroseconds(const uint64 (&Buckets)[LatencyBucketCount], const uint64 Total, const double Percentile)
+	{
+		const uint64 Target = FMath::Max<uint64>(1, FMath::CeilToInt64(Total * Percentile));
+
+		uint64 Running = 0;
+		for (int Bucket = 0; Bucket < LatencyBucketCount; Bucket++) {
+			Running += Buckets[Bucket];
+			if (Running >= Target) {
+				return GetBucketMicroseconds(Bucket);
+			}
+		}
+
+		return GetBucketMicroseconds(LatencyBucketCount - 1);
+	}
+}
+
+double FMinesweeperTournamentResult::GetWinRate() const
+{
+	return Games ? static_cast<double>(Wins) / Games : 0.0;
+}
+
+FString FMinesweeperTournamentResult::ToString() const
+{
+	return FString::Printf(TEXT("%-12s %6d games  win %6.2f%%  %10.0f moves/s  decision mean %.2fus p50 <%.2fus p99 <%.2fus  (%.2fs)"),
+		*AgentName, Games, GetWinRate() * 100.0, MovesPerSecond, MeanDecisionMicroseconds, P50DecisionMicroseconds, P99DecisionMicroseconds, WallSeconds);
+}
+
+FMinesweeperTournamentResult FMinesweeperTournament::Run(const FMinesweeperTournamentSettings& Settings, const FMinesweeperAgentFactory& Factory)
+{
+	using namespace MinesweeperTournament;
+
+	const int MaxMoves = Settings.MaxMovesPerGame > 0 ? Settings.MaxMovesPerGame : Settings.Width * Settings.Height * 4;
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	TArray<FWorkerContext> Contexts;
+	ParallelForWithTaskContext(TEXT("MinesweeperTournament"), Contexts, Settings.GamesPerAgent,
+		[&Factory](const int32 ContextIndex, const int32 NumContexts) {
+			FWorkerContext Context;
+			Context.Agent = Factory();
+			return Context;
+		},
+		[&Settings, MaxMoves](FWorkerContext& Context, const int32 GameIndex) {
+			// Headless, no play area means no widgets and no result overlay
+			const int Seed = Settings.FirstSeed + GameIndex;
+			const TSharedPtr<FMinesweeperGame> Game = FMinesweeperGame::Create(Settings.Width, Settings.Height, Settings.MineCount, Seed);
+
+			// One full copy up front, after that only the tiles an action touched get patched in
+			Game->GetView(Context.View);
+			Game->SetRecordChanges(true);
+			Context.Agent->BeginGame(Context.View, Seed);
+
+			int Moves = 0;
+			while (!Game->IsGameComplete() && Moves < MaxMoves) {
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				const FMinesweeperAction Action = Context.Agent->Decide(Context.View);
+				const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+
+				const uint64 Nanoseconds = static_cast<uint64>(FPlatformTime::ToSeconds64(Cycles) * 1e9);
+				Context.LatencyBuckets[FMath::Min<int>(FMath::FloorLog2_64(FMath::Max<uint64>(Nanoseconds, 1)), LatencyBucketCount - 1)]++;
+				Context.DecisionCycles += Cycles;
+				Moves++;
+
+				if (Game->ApplyAction(Action)) {
+					Game->ConsumeChanges(Context.ChangedCells);
+					for (const int Index : Context.ChangedCells) {
+						Context.View.Cells[Index] = Game->GetViewCell(Index);
+					}
+
+					Context.ChangedCells.Reset();
+					Context.View.FlagsPlaced = Game->FlagsPlaced;
+					Context.View.State = Game->GetState();
+				}
+			}
+
+			Context.Games++;
+			Context.Wins += Game->GetState() == FinishWin;
+			Context.Moves += Moves;
+		},
+		EParallelForFlags::Unbalanced);
+
+	FMinesweeperTournamentResult Result;
+	Result.WallSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+	uint64 DecisionCycles = 0;
+	uint64 Buckets[LatencyBucketCount] = {};
+	for (const FWorkerContext& Context : Contexts) {
+		if (Result.AgentName.IsEmpty() && Context.Agent) {
+			Result.AgentName = Context.Agent->GetName();
+		}
+
+		Result.Games += Context.Games;
+		Result.Wins += Context.Wins;
+		Result.Moves += Context.Moves;
+		DecisionCycles += Context.DecisionCycles;
+
+		for (int Bucket = 0; Bucket < LatencyBucketCount; Bucket++) {
+			Buckets[Bucket] += Context.LatencyBuckets[Bucket];
+		}
+	}
+
+	if (Result.Moves) {
+		Result.MovesPerSecond = Result.WallSeconds > 0.0 ? Result.Moves / Result.WallSeconds : 0.0;
+		Result.MeanDecisionMicroseconds = FPlatformTime::ToSeconds64(DecisionCycles) * 1e6 / Result.Moves;
+		Result.P50DecisionMicroseconds = GetPercentileMicroseconds(Buckets, Result.Moves, 0.5);
+		Result.P99DecisionMicroseconds = GetPercentileMicroseconds(Buckets, Result.Moves, 0.99);
+	}
+
+	return Result;
+}
+
+TArray<FMinesweeperAgentFactory> FMinesweeperTournament::GetBuiltInAgents()
+{
+	return {
+		[] { return TUniquePtr<IMinesweeperAgent>(MakeUnique<FRandomMinesweeperAgent>()); },
+		[] { return TUniquePtr<IMinesweeperAgent>(MakeUnique<FSinglePointMinesweeperAgent>()); }
+	};
+}
+
+static FAutoConsoleCommand MinesweeperTournamentCommand(
+	TEXT("Minesweeper.Tournament"),
+	TEXT("Plays every built in agent on the same seeded boards. Minesweeper.Tournament [Games=1000] [Width=16] [Height=16] [Mines=40]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		FMinesweeperTournamentSettings Settings;
+		Settings.GamesPerAgent = Args.IsValidIndex(0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : Settings.GamesPerAgent;
+		Settings.Width = Args.IsValidIndex(1) ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 4096) : Settings.Width;
+		Settings.Height = Args.IsValidIndex(2) ? FMath::Clamp(FCString::Atoi(*Args[2]), 1, 4096) : Settings.Height;
+		Settings.MineCount = Args.IsValidIndex(3) ? FMath::Clamp(FCString::Atoi(*Args[3]), 1, Settings.Width * Settings.Height) : Settings.MineCount;
+
+		UE_LOG(LogMinesweeper, Display, TEXT("Tournament: %d games per agent on %dx%d with %d mines"), Settings.GamesPerAgent, Settings.Width, Settings.Height, Settings.MineCount);
+
+		for (const FMinesweeperAgentFactory& Factory : FMinesweeperTournament::GetBuiltInAgents()) {
+			const FMinesweeperTournamentResult Result = FMinesweeperTournament::Run(Settings, Factory);
+			UE_LOG(LogMinesweeper, Display, TEXT("%s"), *Result.ToString());
+		}
+	}));
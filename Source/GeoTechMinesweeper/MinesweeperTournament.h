@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperAgent.h"
+
+// Every worker builds its own agent, agents dont have to be thread safe
+using FMinesweeperAgentFactory = TFunction<TUniquePtr<IMinesweeperAgent>()>;
+
+struct FMinesweeperTournamentSettings
+{
+	int Width = 16, Height = 16, MineCount = 40;
+	int GamesPerAgent = 1000;
+
+	// Game N is played on seed FirstSeed + N, so every agent gets the exact same boards
+	int FirstSeed = 1;
+
+	// Stops an agent stuck on actions that dont change anything, 0 picks four times the tile count
+	int MaxMovesPerGame = 0;
+};
+
+struct FMinesweeperTournamentResult
+{
+	FString AgentName;
+	int Games = 0;
+	int Wins = 0;
+	int64 Moves = 0;
+
+	double WallSeconds = 0.0;
+	double MovesPerSecond = 0.0;
+
+	// Per decision latency, upper bounds of the histogram bucket the percentile lands in
+	double MeanDecisionMicroseconds = 0.0;
+	double P50DecisionMicroseconds = 0.0;
+	double P99DecisionMicroseconds = 0.0;
+
+	double GetWinRate() const;
+	FString ToString() const;
+};
+
+// Plays seeded headless games for an agent spread over the task graph. Games are handed out one at a time
+// to whichever worker is free, long games on one thread dont hold up the rest
+class FMinesweeperTournament
+{
+public:
+	static FMinesweeperTournamentResult Run(const FMinesweeperTournamentSettings& Settings, const FMinesweeperAgentFactory& Factory);
+
+	static TArray<FMinesweeperAgentFactory> GetBuiltInAgents();
+};
@@ -0,0 +1,360 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SMinesweeperBoardView.h"
+#include "GeoTechMinesweeper.h"
+
+namespace MinesweeperBoardView
+{
+	constexpr float MaxPixelsPerCell = 64.0f;
+
+	// Below this cells stop being readable, switch to pyramid texels
+	constexpr float MinCellPx = 6.0f;
+
+	// Minimap texels smaller than this just burn draw elements
+	constexpr float MinMinimapTexelPx = 3.0f;
+
+	// Number/icon detail only once there is room for it
+	constexpr float DetailCellPx = 12.0f;
+
+	// Right button drag further than this pans instead of flagging
+	constexpr float PanThresholdPx = 4.0f;
+}
+
+void SMinesweeperBoardView::Construct(const FArguments& InArgs)
+{
+	Game = InArgs._Game;
+	check(Game);
+
+	ViewCenter = FVector2D(Game->Width, Game->Height) * 0.5;
+}
+
+void SMinesweeperBoardView::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SLeafWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	ViewSize = AllottedGeometry.GetLocalSize();
+	PixelsPerCell = FMath::Clamp(PixelsPerCell, GetMinPixelsPerCell(), MinesweeperBoardView::MaxPixelsPerCell);
+
+	Game->GetPyramid().Flush(*Game);
+}
+
+int32 SMinesweeperBoardView::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const FSlateBrush* WhiteBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+
+	// Backdrop so the area outside the board reads as outside
+	FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), WhiteBrush, ESlateDrawEffect::None, FLinearColor(0.02f, 0.02f, 0.02f));
+	LayerId++;
+
+	const int Level = Game->GetPyramid().SelectLevel(PixelsPerCell, MinesweeperBoardView::MinCellPx);
+	if (Level > 0) {
+		return PaintTexels(AllottedGeometry, OutDrawElements, LayerId, Level);
+	}
+
+	return PaintCells(AllottedGeometry, OutDrawElements, LayerId);
+}
+
+FVector2D SMinesweeperBoardView::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return FVector2D(768.0, 512.0);
+}
+
+FReply SMinesweeperBoardView::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	const FKey Button = MouseEvent.GetEffectingButton();
+	if (Button == EKeys::RightMouseButton || Button == EKeys::MiddleMouseButton) {
+		bIsPanning = true;
+		PanDistance = 0.0f;
+		return FReply::Handled().CaptureMouse(SharedThis(this));
+	}
+
+	if (Button == EKeys::LeftMouseButton) {
+		return FReply::Handled();
+	}
+
+	return FReply::Unhandled();
+}
+
+FReply SMinesweeperBoardView::OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	const FKey Button = MouseEvent.GetEffectingButton();
+	const FVector2D Cell = LocalToCell(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()));
+	const int X = FMath::FloorToInt(Cell.X);
+	const int Y = FMath::FloorToInt(Cell.Y);
+	const bool bOnBoard = X >= 0 && Y >= 0 && X < Game->Width && Y < Game->Height;
+
+	if (Button == EKeys::RightMouseButton || Button == EKeys::MiddleMouseButton) {
+		const bool bWasClick = PanDistance < MinesweeperBoardView::PanThresholdPx;
+		bIsPanning = false;
+
+		if (Button == EKeys::RightMouseButton && bWasClick && bOnBoard) {
+			Game->GetTile(X, Y).OnRightClicked();
+		}
+
+		return FReply::Handled().ReleaseMouseCapture();
+	}
+
+	if (Button == EKeys::LeftMouseButton) {
+		if (!bOnBoard) {
+			return FReply::Handled();
+		}
+
+		// Clicking a number thats already out chords it
+		FMinesweeperTile& Tile = Game->GetTile(X, Y);
+		if (!Tile.IsEnabled()) {
+			Game->HandlePlayerAction({ EMinesweeperActionType::Chord, X + Y * Game->Width });
+			return FReply::Handled();
+		}
+
+		return Tile.OnClicked();
+	}
+
+	return FReply::Unhandled();
+}
+
+FReply SMinesweeperBoardView::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (!bIsPanning || !HasMouseCapture()) {
+		return FReply::Unhandled();
+	}
+
+	const FVector2D Delta = MouseEvent.GetCursorDelta() / MyGeometry.Scale;
+	PanDistance += Delta.Size();
+	SetViewCenter(ViewCenter - Delta / PixelsPerCell);
+	return FReply::Handled();
+}
+
+FReply SMinesweeperBoardView::OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	// Zoom around the cursor, the cell under it stays under it
+	const FVector2D Local = MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition());
+	const FVector2D Anchor = LocalToCell(Local);
+
+	PixelsPerCell = FMath::Clamp(PixelsPerCell * FMath::Pow(1.25f, MouseEvent.GetWheelDelta()), GetMinPixelsPerCell(), MinesweeperBoardView::MaxPixelsPerCell);
+	SetViewCenter(Anchor - (Local - ViewSize * 0.5) / PixelsPerCell);
+	return FReply::Handled();
+}
+
+FVector2D SMinesweeperBoardView::GetViewCenter() const
+{
+	return ViewCenter;
+}
+
+void SMinesweeperBoardView::SetViewCenter(const FVector2D InCenter)
+{
+	ViewCenter.X = FMath::Clamp(InCenter.X, 0.0, static_cast<double>(Game->Width));
+	ViewCenter.Y = FMath::Clamp(InCenter.Y, 0.0, static_cast<double>(Game->Height));
+}
+
+FBox2D SMinesweeperBoardView::GetVisibleCells() const
+{
+	return FBox2D(LocalToCell(FVector2D::ZeroVector), LocalToCell(ViewSize));
+}
+
+float SMinesweeperBoardView::GetPixelsPerCell() const
+{
+	return PixelsPerCell;
+}
+
+FVector2D SMinesweeperBoardView::CellToLocal(const FVector2D Cell) const
+{
+	return (Cell - ViewCenter) * PixelsPerCell + ViewSize * 0.5;
+}
+
+FVector2D SMinesweeperBoardView::LocalToCell(const FVector2D Local) const
+{
+	return (Local - ViewSize * 0.5) / PixelsPerCell + ViewCenter;
+}
+
+float SMinesweeperBoardView::GetMinPixelsPerCell() const
+{
+	// Fully zoomed out shows the whole board with some room around it
+	const float Fit = FMath::Min(ViewSize.X / Game->Width, ViewSize.Y / Game->Height);
+	return FMath::Min(Fit * 0.5f, MinesweeperBoardView::MaxPixelsPerCell);
+}
+
+int32 SMinesweeperBoardView::PaintCells(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId) const
+{
+	const FBox2D Visible = GetVisibleCells();
+	const int MinX = FMath::Max(0, FMath::FloorToInt(Visible.Min.X));
+	const int MinY = FMath::Max(0, FMath::FloorToInt(Visible.Min.Y));
+	const int MaxX = FMath::Min(Game->Width - 1, FMath::FloorToInt(Visible.Max.X));
+	const int MaxY = FMath::Min(Game->Height - 1, FMath::FloorToInt(Visible.Max.Y));
+
+	const FSlateBrush* WhiteBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+	const bool bDrawDetail = PixelsPerCell >= MinesweeperBoardView::DetailCellPx;
+	const FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Bold", FMath::Max(1, FMath::RoundToInt(PixelsPerCell * 0.45f)));
+
+	// Leave a pixel between cells as long as they are big enough to spare it
+	const float CellPx = PixelsPerCell >= MinesweeperBoardView::DetailCellPx ? PixelsPerCell - 1.0f : PixelsPerCell;
+	const FVector2f CellSize(CellPx, CellPx);
+	const FVector2f IconSize = CellSize * 0.78f;
+
+	for (int j = MinY; j <= MaxY; j++) {
+		for (int i = MinX; i <= MaxX; i++) {
+			const FMinesweeperTile& Tile = Game->GetTile(i, j);
+			const FVector2f Position(CellToLocal(FVector2D(i, j)));
+
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(CellSize, FSlateLayoutTransform(Position)), WhiteBrush, ESlateDrawEffect::None, Tile.GetBackgroundColor().GetSpecifiedColor());
+
+			if (!bDrawDetail) {
+				continue;
+			}
+
+			const FLinearColor Color = Tile.GetColor().GetSpecifiedColor();
+			if (const FSlateBrush* Icon = Tile.GetImage()) {
+				const FVector2f IconPosition = Position + (CellSize - IconSize) * 0.5f;
+				FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(IconSize, FSlateLayoutTransform(IconPosition)), Icon, ESlateDrawEffect::None, Color);
+			}
+
+			const FText Text = Tile.GetText();
+			if (!Text.IsEmpty()) {
+				const FVector2f TextPosition = Position + FVector2f(PixelsPerCell * 0.3f, PixelsPerCell * 0.1f);
+				FSlateDrawElement::MakeText(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(CellSize, FSlateLayoutTransform(TextPosition)), Text, Font, ESlateDrawEffect::None, Color);
+			}
+		}
+	}
+
+	return LayerId + 1;
+}
+
+int32 SMinesweeperBoardView::PaintTexels(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId, const int Level) const
+{
+	const FMinesweeperLodPyramid& Pyramid = Game->GetPyramid();
+	const FIntPoint LevelSize = Pyramid.GetLevelSize(Level);
+	const int TexelCells = 1 << Level;
+
+	// Only the texels covering the view, independent of board size
+	const FBox2D Visible = GetVisibleCells();
+	const int MinX = FMath::Max(0, FMath::FloorToInt(Visible.Min.X) >> Level);
+	const int MinY = FMath::Max(0, FMath::FloorToInt(Visible.Min.Y) >> Level);
+	const int MaxX = FMath::Min(LevelSize.X - 1, FMath::FloorToInt(Visible.Max.X) >> Level);
+	const int MaxY = FMath::Min(LevelSize.Y - 1, FMath::FloorToInt(Visible.Max.Y) >> Level);
+
+	const FSlateBrush* WhiteBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+	const bool bRevealMines = Game->GetDisplayState() == FinishLose;
+
+	for (int j = MinY; j <= MaxY; j++) {
+		for (int i = MinX; i <= MaxX; i++) {
+			const int CellX = i * TexelCells;
+			const int CellY = j * TexelCells;
+			const FVector2f Position(CellToLocal(FVector2D(CellX, CellY)));
+			const FVector2f Size(FMath::Min(TexelCells, Game->Width - CellX) * PixelsPerCell, FMath::Min(TexelCells, Game->Height - CellY) * PixelsPerCell);
+
+			const FLinearColor Color = FMinesweeperLodPyramid::GetTexelColor(Pyramid.GetTexel(Level, i, j), Pyramid.GetTexelCellCount(Level, i, j), bRevealMines);
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(Size, FSlateLayoutTransform(Position)), WhiteBrush, ESlateDrawEffect::None, Color);
+		}
+	}
+
+	return LayerId;
+}
+
+void SMinesweeperMinimap::Construct(const FArguments& InArgs)
+{
+	Game = InArgs._Game;
+	BoardView = InArgs._BoardView;
+	check(Game);
+}
+
+void SMinesweeperMinimap::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SLeafWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// Whichever of us ticks first does the work, the other finds nothing dirty
+	Game->GetPyramid().Flush(*Game);
+}
+
+int32 SMinesweeperMinimap::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const FMinesweeperLodPyramid& Pyramid = Game->GetPyramid();
+	const FSlateBrush* WhiteBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+	const float PixelsPerCell = GetPixelsPerCell(AllottedGeometry);
+
+	FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), WhiteBrush, ESlateDrawEffect::None, FLinearColor::Black);
+	LayerId++;
+
+	const int Level = Pyramid.SelectLevel(PixelsPerCell, MinesweeperBoardView::MinMinimapTexelPx);
+	const FIntPoint LevelSize = Pyramid.GetLevelSize(Level);
+	const int TexelCells = 1 << Level;
+	const bool bRevealMines = Game->GetDisplayState() == FinishLose;
+
+	for (int j = 0; j < LevelSize.Y; j++) {
+		for (int i = 0; i < LevelSize.X; i++) {
+			const int CellX = i * TexelCells;
+			const int CellY = j * TexelCells;
+			const FVector2f Position(CellX * PixelsPerCell, CellY * PixelsPerCell);
+			const FVector2f Size(FMath::Min(TexelCells, Game->Width - CellX) * PixelsPerCell, FMath::Min(TexelCells, Game->Height - CellY) * PixelsPerCell);
+
+			const FLinearColor Color = FMinesweeperLodPyramid::GetTexelColor(Pyramid.GetTexel(Level, i, j), Pyramid.GetTexelCellCount(Level, i, j), bRevealMines);
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(Size, FSlateLayoutTransform(Position)), WhiteBrush, ESlateDrawEffect::None, Color);
+		}
+	}
+	LayerId++;
+
+	// Outline of what the board view is looking at
+	if (const TSharedPtr<SMinesweeperBoardView> View = BoardView.Pin()) {
+		const FBox2D Visible = View->GetVisibleCells();
+		const FVector2f Min(Visible.Min * PixelsPerCell);
+		const FVector2f Max(Visible.Max * PixelsPerCell);
+
+		TArray<FVector2f> Points = {
+			Min,
+			FVector2f(Max.X, Min.Y),
+			Max,
+			FVector2f(Min.X, Max.Y),
+			Min
+		};
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), MoveTemp(Points), ESlateDrawEffect::None, FLinearColor::Yellow, true, 1.0f);
+	}
+
+	return LayerId;
+}
+
+FVector2D SMinesweeperMinimap::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Keep the board aspect inside a 192px square
+	const float Scale = 192.0f / FMath::Max(Game->Width, Game->Height);
+	return FVector2D(Game->Width * Scale, Game->Height * Scale);
+}
+
+FReply SMinesweeperMinimap::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (MouseEvent.GetEffectingButton() != EKeys::LeftMouseButton) {
+		return FReply::Unhandled();
+	}
+
+	CenterViewOn(MyGeometry, MouseEvent.GetScreenSpacePosition());
+	return FReply::Handled().CaptureMouse(SharedThis(this));
+}
+
+FReply SMinesweeperMinimap::OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (MouseEvent.GetEffectingButton() != EKeys::LeftMouseButton) {
+		return FReply::Unhandled();
+	}
+
+	return FReply::Handled().ReleaseMouseCapture();
+}
+
+FReply SMinesweeperMinimap::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (!HasMouseCapture()) {
+		return FReply::Unhandled();
+	}
+
+	CenterViewOn(MyGeometry, MouseEvent.GetScreenSpacePosition());
+	return FReply::Handled();
+}
+
+float SMinesweeperMinimap::GetPixelsPerCell(const FGeometry& AllottedGeometry) const
+{
+	const FVector2D Size = AllottedGeometry.GetLocalSize();
+	return FMath::Min(Size.X / Game->Width, Size.Y / Game->Height);
+}
+
+void SMinesweeperMinimap::CenterViewOn(const FGeometry& MyGeometry, const FVector2D ScreenPosition) const
+{
+	if (const TSharedPtr<SMinesweeperBoardView> View = BoardView.Pin()) {
+		View->SetViewCenter(MyGeometry.AbsoluteToLocal(ScreenPosition) / GetPixelsPerCell(MyGeometry));
+	}
+}
@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+class FMinesweeperGame;
+
+// Pan/zoom view of the board for sizes the widget grid cant handle.
+// Only cells inside the view get painted, and once cells get smaller than a few pixels it paints pyramid texels instead
+class SMinesweeperBoardView: public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SMinesweeperBoardView)
+		: _Game(nullptr)
+	{}
+		SLATE_ARGUMENT(FMinesweeperGame*, Game)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+
+	// View center in cell units
+	FVector2D GetViewCenter() const;
+	void SetViewCenter(const FVector2D InCenter);
+
+	// Board area currently in view, in cell units
+	FBox2D GetVisibleCells() const;
+
+	float GetPixelsPerCell() const;
+
+protected:
+	FVector2D CellToLocal(const FVector2D Cell) const;
+	FVector2D LocalToCell(const FVector2D Local) const;
+	float GetMinPixelsPerCell() const;
+
+	int32 PaintCells(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId) const;
+	int32 PaintTexels(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId, const int Level) const;
+
+	FMinesweeperGame* Game = nullptr;
+
+	FVector2D ViewCenter = FVector2D::ZeroVector;
+	float PixelsPerCell = 32.0f;
+
+	// Size from the last layout, needed to map the minimap rect back onto the board
+	FVector2D ViewSize = FVector2D(768.0, 512.0);
+
+	bool bIsPanning = false;
+	float PanDistance = 0.0f;
+};
+
+// Whole board at a glance, drawn from the coarsest pyramid level that still fills it.
+// Click or drag to move the board view
+class SMinesweeperMinimap: public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SMinesweeperMinimap)
+		: _Game(nullptr)
+	{}
+		SLATE_ARGUMENT(FMinesweeperGame*, Game)
+		SLATE_ARGUMENT(TSharedPtr<SMinesweeperBoardView>, BoardView)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+
+protected:
+	float GetPixelsPerCell(const FGeometry& AllottedGeometry) const;
+	void CenterViewOn(const FGeometry& MyGeometry, const FVector2D ScreenPosition) const;
+
+	FMinesweeperGame* Game = nullptr;
+	TWeakPtr<SMinesweeperBoardView> BoardView;
+};
@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SMinesweeperPerfHud.h"
+
+#if WITH_MINESWEEPER_PERF_HUD
+
+namespace MinesweeperPerfHud
+{
+	constexpr float Padding = 6.0f;
+	constexpr float LineHeight = 14.0f;
+	constexpr int LineCount = 5;
+	constexpr float HistogramHeight = 40.0f;
+	constexpr float BarWidth = 14.0f;
+	constexpr float Width = 280.0f;
+
+	// 2^14us, about one 60hz frame
+	constexpr int FrameBudgetBucket = 14;
+
+	double CyclesToMs(const uint64 Cycles)
+	{
+		return FPlatformTime::ToMilliseconds64(Cycles);
+	}
+}
+
+void SMinesweeperPerfHud::Construct(const FArguments& InArgs)
+{
+	Game = InArgs._Game;
+	check(Game);
+
+	Font = FCoreStyle::GetDefaultFontStyle("Mono", 9);
+}
+
+void SMinesweeperPerfHud::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SLeafWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	float Evicted;
+	FrameSeconds.Push(InDeltaTime, Evicted);
+
+	float Total = 0.0f;
+	float Max = 0.0f;
+	for (int Age = 0; Age < FrameSeconds.Num; Age++) {
+		const float Seconds = FrameSeconds.GetRecent(Age);
+		Total += Seconds;
+		Max = FMath::Max(Max, Seconds);
+	}
+
+	FrameAverageMs = Total * 1000.0f / FrameSeconds.Num;
+	FrameMaxMs = Max * 1000.0f;
+}
+
+int32 SMinesweeperPerfHud::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	using namespace MinesweeperPerfHud;
+
+	const FSlateBrush* WhiteBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+	const FVector2f Size(ComputeDesiredSize(1.0f));
+
+	FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(Size, FSlateLayoutTransform()), WhiteBrush, ESlateDrawEffect::None, FLinearColor(0.0f, 0.0f, 0.0f, 0.75f));
+	LayerId++;
+
+	// Stack buffer, the text costs nothing beyond what the element list copies
+	TStringBuilder<128> Line;
+	float LineY = Padding;
+	const auto DrawLine = [&] {
+		const FVector2f Position(Padding, LineY);
+		LineY += LineHeight;
+		FSlateDrawElement::MakeText(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(FVector2f(Size.X, LineHeight), FSlateLayoutTransform(Position)), Line.ToString(), 0, Line.Len(), Font, ESlateDrawEffect::None, FLinearColor::White);
+		Line.Reset();
+	};
+
+	Line.Appendf(TEXT("Frame %5.1fms avg %5.1fms max %5.1fms"), FrameSeconds.Num ? FrameSeconds.GetRecent(0) * 1000.0f : 0.0f, FrameAverageMs, FrameMaxMs);
+	DrawLine();
+
+	Line.Appendf(TEXT("Tile widgets %d"), Game->GetTileWidgetCount());
+	DrawLine();
+
+	Line.Appendf(TEXT("Board memory %.1f KB"), Game->GetAllocatedSize() / 1024.0);
+	DrawLine();
+
+	Line.Appendf(TEXT("Last click logic %.2fms paint %.2fms"), LastLogicMs, LastPaintMs);
+	DrawLine();
+
+	Line.Appendf(TEXT("Click to visible %.2fms (%d clicks)"), LastLatencyMs, LatencyHistory.Num);
+	DrawLine();
+
+	// Histogram, scaled to its tallest bucket
+	int MaxBucket = 1;
+	for (int Bucket = 0; Bucket < LatencyBucketCount; Bucket++) {
+		MaxBucket = FMath::Max(MaxBucket, LatencyBuckets[Bucket]);
+	}
+
+	const float Baseline = Padding + LineCount * LineHeight + HistogramHeight;
+	for (int Bucket = 0; Bucket < LatencyBucketCount; Bucket++) {
+		const float Height = FMath::Max(1.0f, HistogramHeight * LatencyBuckets[Bucket] / MaxBucket);
+		const FVector2f Position(Padding + Bucket * BarWidth, Baseline - Height);
+
+		// Green inside a frame, red past it
+		const FLinearColor Color = Bucket < FrameBudgetBucket ? FLinearColor(0.2f, 0.8f, 0.3f) : FLinearColor(0.9f, 0.25f, 0.2f);
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(FVector2f(BarWidth - 2.0f, Height), FSlateLayoutTransform(Position)), WhiteBrush, ESlateDrawEffect::None, Color);
+	}
+
+	LineY = Baseline;
+	Line.Appendf(TEXT("1us%29s"), TEXT("33ms+"));
+	DrawLine();
+
+	return LayerId;
+}
+
+FVector2D SMinesweeperPerfHud::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	using namespace MinesweeperPerfHud;
+	return FVector2D(Width, Padding * 2.0f + (LineCount + 1) * LineHeight + HistogramHeight);
+}
+
+void SMinesweeperPerfHud::BeginClick(const uint64 Command)
+{
+	if (bClickPending) {
+		return;
+	}
+
+	bClickPending = true;
+	ClickCommand = Command;
+	ClickStartCycles = FPlatformTime::Cycles64();
+}
+
+void SMinesweeperPerfHud::EndClickLogic(const uint64 LogicCycles, const uint64 ProcessedCommands)
+{
+	LastLogicMs = MinesweeperPerfHud::CyclesToMs(LogicCycles);
+
+	// An earlier snapshot can land after the click was queued, only the one that includes it counts
+	if (bClickPending && ProcessedCommands >= ClickCommand) {
+		bClickAwaitingPaint = true;
+	}
+}
+
+void SMinesweeperPerfHud::OnBoardPainted(const uint64 PaintCycles)
+{
+	if (!bClickAwaitingPaint) {
+		return;
+	}
+
+	// Visible as far as Slate goes, the draw elements for the new state exist. Presenting them is up to the renderer
+	bClickPending = false;
+	bClickAwaitingPaint = false;
+	LastPaintMs = MinesweeperPerfHud::CyclesToMs(PaintCycles);
+	LastLatencyMs = MinesweeperPerfHud::CyclesToMs(FPlatformTime::Cycles64() - ClickStartCycles);
+
+	const uint64 Microseconds = static_cast<uint64>(LastLatencyMs * 1000.0);
+	const uint8 Bucket = static_cast<uint8>(FMath::Min<int>(FMath::FloorLog2_64(FMath::Max<uint64>(Microseconds, 1)), LatencyBucketCount - 1));
+
+	uint8 Evicted;
+	if (LatencyHistory.Push(Bucket, Evicted)) {
+		LatencyBuckets[Evicted]--;
+	}
+
+	LatencyBuckets[Bucket]++;
+}
+
+void SMinesweeperPaintTimer::Construct(const FArguments& InArgs)
+{
+	PerfHud = InArgs._PerfHud;
+
+	ChildSlot
+	[
+		InArgs._Content.Widget
+	];
+}
+
+int32 SMinesweeperPaintTimer::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const int32 Result = SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	if (PerfHud) {
+		PerfHud->OnBoardPainted(FPlatformTime::Cycles64() - StartCycles);
+	}
+
+	return Result;
+}
+
+#endif
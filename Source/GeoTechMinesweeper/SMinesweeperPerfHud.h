@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GeoTechMinesweeper.h"
+
+#if WITH_MINESWEEPER_PERF_HUD
+
+#include "Containers/StaticArray.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/SLeafWidget.h"
+
+// Fixed size history, the oldest sample gets overwritten. Never allocates after construction
+template<typename SampleType, int Capacity>
+struct TMinesweeperSampleRing
+{
+	TStaticArray<SampleType, Capacity> Samples { InPlace, SampleType() };
+	int Head = 0;
+	int Num = 0;
+
+	// Returns true and the sample that fell out when the ring was already full
+	bool Push(const SampleType Sample, SampleType& OutEvicted)
+	{
+		const bool bFull = Num == Capacity;
+		OutEvicted = Samples[Head];
+		Samples[Head] = Sample;
+		Head = (Head + 1) % Capacity;
+		Num = FMath::Min(Num + 1, Capacity);
+		return bFull;
+	}
+
+	// 0 is the newest sample
+	SampleType GetRecent(const int Age) const
+	{
+		return Samples[(Head - 1 - Age + Capacity) % Capacity];
+	}
+};
+
+// Overlay with frame time, tile widget count, board memory, last click cost and a click to visible histogram.
+// Samples go into fixed rings, the overlay only ticks while it is visible. Compiled out of shipping builds
+class SMinesweeperPerfHud: public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SMinesweeperPerfHud)
+		: _Game(nullptr)
+	{}
+		SLATE_ARGUMENT(FMinesweeperGame*, Game)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+	// When a player action gets queued as the Command'th one, and once a snapshot lands with the time the simulation spent on it.
+	// Clicks queued while one is already being timed are left out, the sample runs from the oldest until its command is painted
+	void BeginClick(const uint64 Command);
+	void EndClickLogic(const uint64 LogicCycles, const uint64 ProcessedCommands);
+
+	// From the board's paint, the first one after a click closes its latency sample
+	void OnBoardPainted(const uint64 PaintCycles);
+
+	// Log2 buckets of microseconds, the last one catches everything from ~33ms up
+	static constexpr int LatencyBucketCount = 16;
+
+protected:
+	FMinesweeperGame* Game = nullptr;
+	FSlateFontInfo Font;
+
+	TMinesweeperSampleRing<float, 120> FrameSeconds;
+	float FrameAverageMs = 0.0f;
+	float FrameMaxMs = 0.0f;
+
+	uint64 ClickStartCycles = 0;
+	uint64 ClickCommand = 0;
+	bool bClickPending = false;
+	bool bClickAwaitingPaint = false;
+	double LastLogicMs = 0.0;
+	double LastPaintMs = 0.0;
+
+	// Rolling, the bucket of an evicted sample is taken back out
+	TMinesweeperSampleRing<uint8, 256> LatencyHistory;
+	TStaticArray<int, LatencyBucketCount> LatencyBuckets { InPlace, 0 };
+	double LastLatencyMs = 0.0;
+};
+
+// Times the paint of whatever it wraps and hands it to the HUD
+class SMinesweeperPaintTimer: public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SMinesweeperPaintTimer)
+	{}
+		SLATE_ARGUMENT(TSharedPtr<SMinesweeperPerfHud>, PerfHud)
+		SLATE_DEFAULT_SLOT(FArguments, Content)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	TSharedPtr<SMinesweeperPerfHud> PerfHud;
+};
+
+#endif